@@ -0,0 +1,173 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <Glacier/Enums.h>
+#include <Glacier/ZEntity.h>
+#include <Glacier/ZMath.h>
+#include "RepoId.h"
+
+class ZActor;
+class ZSpatialEntity;
+
+// What a frame's actor scan changed, which the event thread adds to the stats
+struct ActorScanChanges
+{
+	int tension = 0;
+	int closeCombatEngagements = 0;
+
+	explicit operator bool() const { return this->tension || this->closeCombatEngagements; }
+};
+
+// Actor scan figures for the settings UI and logs, published by the game thread
+struct ActorScanStats
+{
+	size_t liveCount = 0;
+	size_t priorityCount = 0;
+	int frames = 0;
+	// In microseconds
+	double averageScanTime = 0;
+	// In seconds, smoothed
+	double averageFrameTime = 0;
+};
+
+// Actor state for the current contract, stored as a structure of arrays.
+// Everything the per-frame scan reads is kept densely by live actor, including the slot reference and cached spatial
+// entity, so it only walks contiguous arrays. What's only needed when an actor is resolved is indexed by actor slot.
+// The interfaces are cached, so the scan compares the slot's current actor with the cached one before using them,
+// and resolves the slot again if it was given to another actor.
+// Templated on the game's actor types so ActorScanBenchmark can run the same scan on stand-ins.
+template<typename TActor, typename TSpatial>
+class BasicActorTable
+{
+public:
+	static constexpr size_t Capacity = 1000;
+	// Actors within this many metres of the player are rescanned every frame when the scan is budgeted
+	static constexpr float NearPlayerDistance = 20.0f;
+
+	auto clear() -> void {
+		this->liveCount = 0;
+		this->scanCursor = 0;
+		this->repoId.fill({});
+		this->isTarget.fill(false);
+	}
+
+	// Adds a slot to the scan, returning its live index. The slot's actor is resolved by the scan.
+	auto addLive(uint16_t slot, const TEntityRef<TActor>* ref) -> size_t {
+		auto const i = this->liveCount++;
+		this->liveSlot[i] = slot;
+		this->liveRef[i] = ref;
+		this->reset(i, nullptr);
+		return i;
+	}
+
+	// Starts tracking a different actor at a live index, forgetting the previous one's state.
+	auto reset(size_t i, TActor* actor) -> void {
+		this->liveActor[i] = actor;
+		this->liveSpatial[i] = nullptr;
+		this->lastBehaviour[i] = ECompiledBehaviorType::BT_Invalid;
+		this->highestTension[i] = 0;
+		this->nearPlayer[i] = false;
+	}
+
+	// Removes the live actors in slots from slotCount onwards, keeping the others in order.
+	auto truncate(size_t slotCount) -> void {
+		size_t kept = 0;
+		for (size_t i = 0; i < this->liveCount; ++i) {
+			if (this->liveSlot[i] >= slotCount) continue;
+			this->liveRef[kept] = this->liveRef[i];
+			this->liveActor[kept] = this->liveActor[i];
+			this->liveSpatial[kept] = this->liveSpatial[i];
+			this->lastBehaviour[kept] = this->lastBehaviour[i];
+			this->highestTension[kept] = this->highestTension[i];
+			this->nearPlayer[kept] = this->nearPlayer[i];
+			this->liveSlot[kept] = this->liveSlot[i];
+			++kept;
+		}
+		this->liveCount = kept;
+	}
+
+	auto size() const { return this->liveCount; }
+
+	// Scans for behaviour changes, once per frame. With a budget of more than one frame, each frame scans a rotating
+	// slice so every actor is seen within scanFrames frames. Actors near the player or which already raised tension can
+	// escalate at any moment, so they're scanned every frame - the player's position is needed to tell which are near.
+	// refresh(liveIndex, actor) is called for an actor whose slot was given to another actor or which had no spatial
+	// entity yet, and returns whether it can be scanned. onBehaviourChanged(liveIndex, behaviourType) is called after
+	// lastBehaviour is updated. Returns the number of priority actors scanned outside the slice.
+	template<typename TKnowledgeData, typename TRefresh, typename TOnBehaviourChanged>
+	auto scan(
+		size_t scanFrames,
+		const SVector3* playerPosition,
+		const TKnowledgeData& knowledgeData,
+		TRefresh&& refresh,
+		TOnBehaviourChanged&& onBehaviourChanged
+	) -> size_t {
+		auto const liveCount = this->liveCount;
+		scanFrames = scanFrames ? scanFrames : 1;
+
+		auto const sliceStart = this->scanCursor < liveCount ? this->scanCursor : 0;
+		auto const sliceEnd = sliceStart + (liveCount + scanFrames - 1) / scanFrames;
+		this->scanCursor = liveCount ? sliceEnd % liveCount : 0;
+
+		auto const checkNearPlayer = scanFrames > 1 && playerPosition;
+		size_t priorityCount = 0;
+
+		// Hot loop - checks each scanned actor is still the one in its slot, then compares its behaviour to the last scan's
+		for (size_t i = 0; i < liveCount; ++i) {
+			auto const inSlice = (i >= sliceStart && i < sliceEnd) || i + liveCount < sliceEnd;
+
+			if (!inSlice) {
+				if (!this->nearPlayer[i] && !this->highestTension[i]) continue;
+				++priorityCount;
+			}
+
+			// The slot may have been given to another actor, or not had its spatial entity yet when it was last looked at
+			auto const actor = this->liveRef[i]->m_pInterfaceRef;
+			if ((actor != this->liveActor[i] || !this->liveSpatial[i]) && !refresh(i, actor)) continue;
+
+			if (inSlice && checkNearPlayer) {
+				auto const actorPosition = this->liveSpatial[i]->GetWorldMatrix().Trans;
+				auto const dx = actorPosition.x - playerPosition->x;
+				auto const dy = actorPosition.y - playerPosition->y;
+				auto const dz = actorPosition.z - playerPosition->z;
+				this->nearPlayer[i] = dx * dx + dy * dy + dz * dz < NearPlayerDistance * NearPlayerDistance;
+			}
+
+			auto const behaviourIndex = actor->m_nCurrentBehaviorIndex;
+			if (behaviourIndex < 0) continue;
+
+			// (&behaviour + 0xD8) = m_pPreviousBehavior ?
+			auto const behaviour = knowledgeData[behaviourIndex].m_pCurrentBehavior;
+			if (!behaviour) continue;
+
+			auto const behaviourType = static_cast<ECompiledBehaviorType>(behaviour->m_Type);
+			if (behaviourType == this->lastBehaviour[i]) continue;
+
+			this->lastBehaviour[i] = behaviourType;
+			onBehaviourChanged(i, behaviourType);
+		}
+
+		return priorityCount;
+	}
+
+public:
+	// Hot, indexed by live actor
+	std::array<const TEntityRef<TActor>*, Capacity> liveRef;
+	std::array<TActor*, Capacity> liveActor;
+	std::array<TSpatial*, Capacity> liveSpatial;
+	std::array<ECompiledBehaviorType, Capacity> lastBehaviour;
+	std::array<uint8_t, Capacity> highestTension;
+	std::array<bool, Capacity> nearPlayer;
+	std::array<uint16_t, Capacity> liveSlot;
+
+	// Cold, indexed by actor slot
+	std::array<RepoId, Capacity> repoId = {};
+	std::array<bool, Capacity> isTarget = {};
+
+private:
+	size_t liveCount = 0;
+	size_t scanCursor = 0;
+};
+
+using ActorTable = BasicActorTable<ZActor, ZSpatialEntity>;
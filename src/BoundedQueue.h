@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+// Lock-free multiple producer, multiple consumer queue with a fixed capacity.
+// Each slot carries a sequence number saying whether it's ready to be written or read for the current lap,
+// so producers and consumers only contend on their own position counter. Pushing to a full queue fails.
+template<typename T, size_t Capacity>
+class BoundedQueue
+{
+	static_assert(std::has_single_bit(Capacity), "BoundedQueue capacity must be a power of two");
+
+	struct Slot
+	{
+		std::atomic<size_t> sequence;
+		alignas(T) std::byte storage[sizeof(T)];
+
+		auto value() -> T* { return std::launder(reinterpret_cast<T*>(this->storage)); }
+	};
+
+public:
+	BoundedQueue() {
+		for (size_t i = 0; i < Capacity; ++i)
+			this->slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	~BoundedQueue() {
+		while (this->pop());
+	}
+
+	BoundedQueue(const BoundedQueue&) = delete;
+	auto operator=(const BoundedQueue&) -> BoundedQueue& = delete;
+
+	// Returns false if the queue is full, in which case value isn't moved from.
+	auto push(T&& value) -> bool {
+		auto pos = this->head.load(std::memory_order_relaxed);
+
+		while (true) {
+			auto& slot = this->slots[pos & (Capacity - 1)];
+			auto const sequence = slot.sequence.load(std::memory_order_acquire);
+			auto const diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos);
+
+			if (diff == 0) {
+				if (this->head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					new (slot.storage) T(std::move(value));
+					slot.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0) return false;
+			else pos = this->head.load(std::memory_order_relaxed);
+		}
+	}
+
+	auto pop() -> std::optional<T> {
+		auto pos = this->tail.load(std::memory_order_relaxed);
+
+		while (true) {
+			auto& slot = this->slots[pos & (Capacity - 1)];
+			auto const sequence = slot.sequence.load(std::memory_order_acquire);
+			auto const diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos + 1);
+
+			if (diff == 0) {
+				if (this->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					std::optional<T> value(std::move(*slot.value()));
+					std::destroy_at(slot.value());
+					slot.sequence.store(pos + Capacity, std::memory_order_release);
+					return value;
+				}
+			}
+			else if (diff < 0) return std::nullopt;
+			else pos = this->tail.load(std::memory_order_relaxed);
+		}
+	}
+
+private:
+	std::array<Slot, Capacity> slots;
+	alignas(64) std::atomic<size_t> head = 0;
+	alignas(64) std::atomic<size_t> tail = 0;
+};
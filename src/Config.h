@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <string>
 #include <IPluginInterface.h>
 
@@ -23,7 +24,9 @@ struct ConfigData
 	bool liveSplitEnabled = false;
 	std::string liveSplitIP = "127.0.0.1";
 	uint16_t liveSplitPort = 16834;
+	bool liveSplitIGTFeed = false;
 	int freelancerSA = 0;
+	int actorScanFrames = 1;
 };
 
 class Config
@@ -39,9 +42,11 @@ public:
 		data.inGameOverlay = plugin.GetSettingBool("general", "overlay", data.inGameOverlay);
 		data.inGameOverlayDetailed = plugin.GetSettingBool("general", "overlay_detailed", data.inGameOverlayDetailed);
 		data.hudIcon = plugin.GetSettingBool("general", "hud_icon", data.hudIcon);
+		data.actorScanFrames = std::clamp(static_cast<int>(plugin.GetSettingInt("general", "actor_scan_frames", data.actorScanFrames)), 1, 60);
 		data.liveSplitEnabled = plugin.GetSettingBool("livesplit", "enabled", data.liveSplitEnabled);
 		data.liveSplitIP = plugin.GetSetting("livesplit", "ip", data.liveSplitIP);
 		data.liveSplitPort = plugin.GetSettingInt("livesplit", "port", data.liveSplitPort);
+		data.liveSplitIGTFeed = plugin.GetSettingBool("livesplit", "igt_feed", data.liveSplitIGTFeed);
 
 		auto overlayDock = plugin.GetSetting("general", "overlay_dock", "");
 
@@ -66,9 +71,11 @@ public:
 		plugin.SetSettingBool("general", "overlay", data.inGameOverlay);
 		plugin.SetSettingBool("general", "overlay_detailed", data.inGameOverlayDetailed);
 		plugin.SetSettingBool("general", "hud_icon", data.hudIcon);
+		plugin.SetSettingInt("general", "actor_scan_frames", data.actorScanFrames);
 		plugin.SetSettingBool("livesplit", "enabled", data.liveSplitEnabled);
 		plugin.SetSetting("livesplit", "ip", data.liveSplitIP);
 		plugin.SetSettingInt("livesplit", "port", data.liveSplitPort);
+		plugin.SetSettingBool("livesplit", "igt_feed", data.liveSplitIGTFeed);
 		
 		auto spinOverlayDock = "none";
 		switch (data.overlayDockMode) {
@@ -0,0 +1,142 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "Enums.h"
+
+// Groups of Stats fields which derived stats can depend on.
+enum class StatFields : uint32_t
+{
+	None = 0,
+	Kills = 1 << 0, // kills, killMethods
+	Pacifies = 1 << 1, // pacifies, pacifyMethods
+	Witnesses = 1 << 2, // witnesses, witnessEvents, targetBodyWitnesses, targetKillNoticers
+	SpottedBy = 1 << 3, // spottedBy, targetsSpottedBy
+	Bodies = 1 << 4,
+	Detection = 1 << 5,
+	Tension = 1 << 6,
+	Current = 1 << 7,
+	Disguises = 1 << 8, // disguisesBlown
+	Items = 1 << 9, // itemsObtained, itemsDisposed
+	Misc = 1 << 10,
+	Targets = 1 << 11, // known target NPCs, used by IsRepoIdTargetNPC
+	All = (1 << 12) - 1,
+};
+
+constexpr auto operator|(StatFields a, StatFields b) -> StatFields {
+	return static_cast<StatFields>(std::to_underlying(a) | std::to_underlying(b));
+}
+
+constexpr auto operator&(StatFields a, StatFields b) -> StatFields {
+	return static_cast<StatFields>(std::to_underlying(a) & std::to_underlying(b));
+}
+
+constexpr auto operator|=(StatFields& a, StatFields b) -> StatFields& {
+	return a = a | b;
+}
+
+constexpr auto operator!(StatFields a) -> bool {
+	return std::to_underlying(a) == 0;
+}
+
+// Fields read by Stealthometer::GetSilentAssassinStatus and CalculateStealthRating.
+constexpr auto silentAssassinStatFields = StatFields::Kills | StatFields::Witnesses | StatFields::SpottedBy | StatFields::Bodies | StatFields::Detection | StatFields::Targets;
+constexpr auto stealthRatingStatFields = StatFields::Kills | StatFields::Pacifies | StatFields::Witnesses | StatFields::Bodies | StatFields::Detection;
+
+// Stats fields modified by the handler of each event.
+// Must be kept in sync with Stealthometer::SetupEvents. Contract start/load reset everything in NewContract.
+constexpr auto getEventStatFields(Events event) -> StatFields {
+	switch (event) {
+		case Events::Kill:
+			return StatFields::Kills | StatFields::Detection | StatFields::Witnesses | StatFields::SpottedBy | StatFields::Bodies;
+		case Events::Pacify:
+			return StatFields::Pacifies | StatFields::Bodies;
+		case Events::CrowdNPC_Died:
+		case Events::Unnoticed_Kill:
+			return StatFields::Kills;
+		case Events::NoticedKill:
+			return StatFields::Kills | StatFields::Witnesses;
+		case Events::Noticed_Pacified:
+		case Events::Unnoticed_Pacified:
+			return StatFields::Pacifies;
+		case Events::Spotted:
+			return StatFields::SpottedBy | StatFields::Detection;
+		case Events::Witnesses:
+			return StatFields::Witnesses;
+		case Events::AccidentBodyFound:
+		case Events::MurderedBodySeen:
+		case Events::BodyFound:
+			return StatFields::Bodies | StatFields::Witnesses;
+		case Events::DeadBodySeen:
+		case Events::TargetBodySpotted:
+		case Events::BodyHidden:
+		case Events::BodyBagged:
+		case Events::AllBodiesHidden:
+			return StatFields::Bodies;
+		case Events::SituationContained:
+		case Events::_47_FoundTrespassing:
+			return StatFields::Detection;
+		case Events::SecuritySystemRecorder:
+			return StatFields::Detection | StatFields::Misc;
+		case Events::DisguiseBlown:
+		case Events::BrokenDisguiseCleared:
+			return StatFields::Disguises | StatFields::Current;
+		case Events::AmbientChanged:
+			return StatFields::Tension | StatFields::Current;
+		case Events::Trespassing:
+		case Events::HoldingIllegalWeapon:
+		case Events::StartingSuit:
+			return StatFields::Current | StatFields::Misc;
+		case Events::ItemPickedUp:
+		case Events::ItemDropped:
+		case Events::ItemThrown:
+		case Events::ItemRemovedFromInventory:
+			return StatFields::Items | StatFields::Misc;
+		case Events::Actorsick:
+		case Events::Agility_Start:
+		case Events::Drain_Pipe_Climbed:
+		case Events::Disguise:
+		case Events::Door_Unlocked:
+		case Events::ShotsFired:
+		case Events::setpieces:
+			return StatFields::Misc;
+		case Events::AddSyndicateTarget:
+			return StatFields::Targets;
+		default:
+			return StatFields::None;
+	}
+}
+
+// Value computed from Stats which is only re-evaluated when the fields it depends on have changed.
+template<typename T>
+class DerivedStat
+{
+public:
+	explicit DerivedStat(StatFields dependencies) : dependencies(dependencies)
+	{}
+
+	// Returns true if the value was recomputed.
+	template<typename TFunc>
+	auto update(StatFields changed, TFunc&& compute) -> bool {
+		if (this->valid && !(changed & this->dependencies)) return false;
+		this->value = std::forward<TFunc>(compute)();
+		this->valid = true;
+		++this->recomputeCount;
+		return true;
+	}
+
+	auto reset() -> void {
+		this->valid = false;
+		this->recomputeCount = 0;
+	}
+
+	auto get() const -> const T& { return this->value; }
+	auto getDependencies() const { return this->dependencies; }
+	auto getRecomputeCount() const { return this->recomputeCount; }
+
+private:
+	StatFields dependencies;
+	T value = {};
+	bool valid = false;
+	int recomputeCount = 0;
+};
@@ -76,6 +76,7 @@ enum class Events {
 	Unnoticed_Kill,
 	Unnoticed_Pacified,
 	Witnesses,
+	_Count, // Number of events, keep last
 };
 
 enum class SecuritySystemRecorderEvent {
@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// What the game thread hands to the event thread, which owns the stats.
+enum class EventRecordType : uint32_t
+{
+	// A game event's JSON
+	GameEvent,
+	// ActorScanChanges from a frame's actor scan
+	ActorScan,
+	// The repository ID of a target the actor scan found
+	ActorTarget,
+	SceneCleared,
+};
+
+struct EventRecord
+{
+	EventRecordType type = EventRecordType::GameEvent;
+	// For actor scan records, the contract the scan was for
+	uint32_t contract = 0;
+	// Game time by the game thread's count when pushed, as the consumer may only get to it frames later
+	double gameTime = 0;
+};
+
+// Lock-free single producer, single consumer queue of length-prefixed records in a fixed size ring buffer.
+// The producer never blocks; if the consumer falls too far behind, new records are dropped.
+class EventQueue
+{
+public:
+	explicit EventQueue(size_t capacity = 1 << 20) : capacity(std::bit_ceil(capacity)), buffer(std::make_unique<char[]>(this->capacity))
+	{ }
+
+	// Producer only.
+	auto push(const EventRecord& record, std::string_view data) -> bool {
+		auto const size = static_cast<uint32_t>(data.size());
+		auto const head = this->head.load(std::memory_order_relaxed);
+		auto const tail = this->tail.load(std::memory_order_acquire);
+
+		if (this->capacity - (head - tail) < headerSize + size)
+			return false;
+
+		this->write(head, &size, sizeof(size));
+		this->write(head + sizeof(size), &record, sizeof(record));
+		this->write(head + headerSize, data.data(), size);
+		this->head.store(head + headerSize + size, std::memory_order_release);
+		this->wake();
+		return true;
+	}
+
+	// Consumer only. Blocks until a record is available or the queue is closed.
+	auto pop(EventRecord& record, std::string& data) -> bool {
+		auto const tail = this->tail.load(std::memory_order_relaxed);
+		auto head = this->head.load(std::memory_order_acquire);
+
+		while (head == tail) {
+			auto const wakeCount = this->wakeCount.load(std::memory_order_acquire);
+			head = this->head.load(std::memory_order_acquire);
+			if (head != tail) break;
+			if (this->closed.load(std::memory_order_acquire)) return false;
+			this->wakeCount.wait(wakeCount, std::memory_order_acquire);
+			head = this->head.load(std::memory_order_acquire);
+		}
+
+		uint32_t size = 0;
+		this->read(tail, &size, sizeof(size));
+		this->read(tail + sizeof(size), &record, sizeof(record));
+		data.resize(size);
+		this->read(tail + headerSize, data.data(), size);
+		this->tail.store(tail + headerSize + size, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only.
+	auto empty() const -> bool {
+		return this->head.load(std::memory_order_acquire) == this->tail.load(std::memory_order_relaxed);
+	}
+
+	// Wakes the consumer and makes pop return false once the queue has been drained.
+	auto close() -> void {
+		this->closed.store(true, std::memory_order_release);
+		this->wake();
+	}
+
+private:
+	static constexpr size_t headerSize = sizeof(uint32_t) + sizeof(EventRecord);
+
+	auto wake() -> void {
+		this->wakeCount.fetch_add(1, std::memory_order_release);
+		this->wakeCount.notify_one();
+	}
+
+	auto write(uint64_t pos, const void* data, size_t size) -> void {
+		auto const offset = static_cast<size_t>(pos & (this->capacity - 1));
+		auto const first = std::min(size, this->capacity - offset);
+		std::memcpy(this->buffer.get() + offset, data, first);
+		std::memcpy(this->buffer.get(), static_cast<const char*>(data) + first, size - first);
+	}
+
+	auto read(uint64_t pos, void* data, size_t size) const -> void {
+		auto const offset = static_cast<size_t>(pos & (this->capacity - 1));
+		auto const first = std::min(size, this->capacity - offset);
+		std::memcpy(data, this->buffer.get() + offset, first);
+		std::memcpy(static_cast<char*>(data) + first, this->buffer.get(), size - first);
+	}
+
+private:
+	const size_t capacity;
+	std::unique_ptr<char[]> buffer;
+	alignas(64) std::atomic<uint64_t> head = 0;
+	alignas(64) std::atomic<uint64_t> tail = 0;
+	std::atomic<uint32_t> wakeCount = 0;
+	std::atomic_bool closed = false;
+};
@@ -1,6 +1,8 @@
+#include <bit>
 #include "EventSystem.h"
+#include "Events.h"
 
-std::unordered_set<std::string> eventNameBlacklist = {
+static constexpr std::string_view eventNameBlacklist[] = {
 	// Map-specific Perma Shortcut Events
 	"Bulldog_Ladder_A_Open",
 	"Bulldog_Ladder_B_Open",
@@ -107,3 +109,187 @@ std::unordered_set<std::string> eventNameBlacklist = {
 	"SupplierVisited",
 	"TargetPickedConfirm",
 };
+
+template<Events TEvent>
+static constexpr auto getEventNameEntry() -> EventNameEntry {
+	if constexpr (requires { Event<TEvent>::Name; })
+		return {Event<TEvent>::Name, EventNameType::Event, TEvent};
+	else
+		return {};
+}
+
+template<size_t... Indices>
+static constexpr auto getEventNameEntries(std::index_sequence<Indices...>) {
+	std::array<EventNameEntry, sizeof...(Indices) + std::size(eventNameBlacklist)> entries{getEventNameEntry<static_cast<Events>(Indices)>()...};
+	for (size_t i = 0; i < std::size(eventNameBlacklist); ++i)
+		entries[sizeof...(Indices) + i] = {eventNameBlacklist[i], EventNameType::Blacklisted};
+	return entries;
+}
+
+static constexpr auto hashEventName(std::string_view name) -> uint64_t {
+	uint64_t hash = 0xCBF29CE484222325;
+	for (auto c : name) {
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x100000001B3;
+	}
+	return hash;
+}
+
+static constexpr auto mixEventNameHash(uint32_t hash) -> uint32_t {
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6B;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+// Hash and displace: names are grouped into buckets by the upper half of their hash, then each bucket gets a seed
+// which places all of its names into free slots, filling the largest buckets first.
+template<size_t N>
+class EventNameTable
+{
+public:
+	static constexpr size_t BucketCount = std::bit_ceil(N / 2);
+	static constexpr size_t SlotCount = std::bit_ceil(N * 3);
+	static constexpr uint8_t EmptySlot = 0xFF;
+
+	static_assert(N < EmptySlot, "Too many event names for 8-bit slots");
+
+	constexpr EventNameTable(const std::array<EventNameEntry, N>& entries) : entries(entries) {
+		this->slots.fill(EmptySlot);
+
+		std::array<uint64_t, N> hashes{};
+		std::array<size_t, BucketCount + 1> bucketStarts{};
+		std::array<size_t, N> bucketEntries{};
+		std::array<size_t, BucketCount> bucketOrder{};
+
+		for (size_t i = 0; i < N; ++i) {
+			if (this->entries[i].type == EventNameType::Unknown) continue;
+			hashes[i] = hashEventName(this->entries[i].name);
+			++bucketStarts[getBucket(hashes[i]) + 1];
+		}
+
+		for (size_t i = 0; i < BucketCount; ++i) {
+			bucketStarts[i + 1] += bucketStarts[i];
+			bucketOrder[i] = i;
+		}
+
+		auto bucketEnds = bucketStarts;
+
+		for (size_t i = 0; i < N; ++i) {
+			if (this->entries[i].type == EventNameType::Unknown) continue;
+			bucketEntries[bucketEnds[getBucket(hashes[i])]++] = i;
+		}
+
+		auto const bucketSize = [&](size_t bucket) {
+			return bucketStarts[bucket + 1] - bucketStarts[bucket];
+		};
+
+		for (size_t i = 1; i < BucketCount; ++i) {
+			for (size_t j = i; j > 0 && bucketSize(bucketOrder[j]) > bucketSize(bucketOrder[j - 1]); --j)
+				std::swap(bucketOrder[j], bucketOrder[j - 1]);
+		}
+
+		for (auto bucket : bucketOrder) {
+			if (!bucketSize(bucket)) break;
+
+			for (uint32_t seed = 0;; ++seed) {
+				if (seed == 0x10000) throw "Failed to generate event name table";
+
+				auto placed = this->slots;
+				auto placedAll = true;
+
+				for (auto i = bucketStarts[bucket]; i < bucketStarts[bucket + 1] && placedAll; ++i) {
+					auto& slot = placed[getSlot(hashes[bucketEntries[i]], seed)];
+					placedAll = slot == EmptySlot;
+					slot = static_cast<uint8_t>(bucketEntries[i]);
+				}
+
+				if (placedAll) {
+					this->slots = placed;
+					this->seeds[bucket] = seed;
+					break;
+				}
+			}
+		}
+	}
+
+	constexpr auto find(std::string_view name) const -> const EventNameEntry& {
+		auto const hash = hashEventName(name);
+		auto const index = this->slots[getSlot(hash, this->seeds[getBucket(hash)])];
+		if (index != EmptySlot && this->entries[index].name == name)
+			return this->entries[index];
+		return unknownEntry;
+	}
+
+private:
+	static constexpr auto getBucket(uint64_t hash) -> size_t {
+		return static_cast<size_t>(hash >> 32) & (BucketCount - 1);
+	}
+
+	static constexpr auto getSlot(uint64_t hash, uint32_t seed) -> size_t {
+		return mixEventNameHash(static_cast<uint32_t>(hash) ^ (seed * 0x9E3779B9)) & (SlotCount - 1);
+	}
+
+private:
+	static constexpr EventNameEntry unknownEntry{};
+
+	std::array<EventNameEntry, N> entries;
+	std::array<uint32_t, BucketCount> seeds{};
+	std::array<uint8_t, SlotCount> slots{};
+};
+
+static constexpr auto eventNameEntries = getEventNameEntries(std::make_index_sequence<std::to_underlying(Events::_Count)>());
+static constexpr EventNameTable<eventNameEntries.size()> eventNameTable(eventNameEntries);
+
+auto lookupEventName(std::string_view name) -> const EventNameEntry& {
+	return eventNameTable.find(name);
+}
+
+template<Events TEvent>
+static auto dispatchEvent(const EventSystem& events, const RawEvent& ev) -> bool {
+	auto const& handlers = events.getHandlers<TEvent>();
+	if (handlers.empty() || ev.ValueOffset == std::string_view::npos) return false;
+
+	JsonReader reader(ev.Json, ev.ValueOffset);
+	ServerEvent<TEvent> serverEvent{typename Event<TEvent>::EventValue(reader)};
+	serverEvent.Raw = ev.Json;
+	serverEvent.Name = ev.Name;
+	serverEvent.ContractId = ev.ContractId;
+	serverEvent.ContractSessionId = ev.ContractSessionId;
+	serverEvent.Timestamp = ev.Timestamp;
+
+	for (auto const& handler : handlers)
+		handler(serverEvent);
+
+	return true;
+}
+
+using EventDispatchFunc = bool(*)(const EventSystem&, const RawEvent&);
+
+template<Events TEvent>
+static constexpr auto getEventDispatchFunc() -> EventDispatchFunc {
+	if constexpr (requires { Event<TEvent>::Name; })
+		return &dispatchEvent<TEvent>;
+	else
+		return nullptr;
+}
+
+template<size_t... Indices>
+static constexpr auto getEventDispatchTable(std::index_sequence<Indices...>) {
+	return std::array<EventDispatchFunc, sizeof...(Indices)>{getEventDispatchFunc<static_cast<Events>(Indices)>()...};
+}
+
+static constexpr auto eventDispatchTable = getEventDispatchTable(std::make_index_sequence<std::to_underlying(Events::_Count)>());
+
+auto EventSystem::handle(const RawEvent& ev) const -> bool {
+	auto const& entry = lookupEventName(ev.Name);
+	if (entry.type != EventNameType::Event) return false;
+	return this->handle(entry.event, ev);
+}
+
+auto EventSystem::handle(Events ev, const RawEvent& raw) const -> bool {
+	auto const dispatch = eventDispatchTable[std::to_underlying(ev)];
+	return dispatch && dispatch(*this, raw);
+}
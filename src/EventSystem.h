@@ -1,132 +1,127 @@
 #pragma once
-#include <functional>
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
-#include <unordered_set>
-#include <unordered_map>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
 #include "json.hpp"
+#include "Enums.h"
+#include "InlineDelegate.h"
+#include "JsonReader.h"
 
-enum class Events;
 template<Events>
 struct Event;
 
+// Top-level fields of an event, read without decoding the event value.
+struct RawEvent
+{
+	std::string_view Json;
+	std::string_view Name;
+	std::string_view ContractId;
+	std::string_view ContractSessionId;
+	double Timestamp = 0;
+	size_t ValueOffset = std::string_view::npos;
+
+	static auto read(std::string_view json) -> RawEvent {
+		RawEvent ev;
+		ev.Json = json;
+
+		JsonReader reader(json);
+		reader.readObject([&ev](std::string_view key, JsonReader& reader) {
+			if (key == "Name") ev.Name = reader.readStringView();
+			else if (key == "ContractId") ev.ContractId = reader.readStringView();
+			else if (key == "ContractSessionId") ev.ContractSessionId = reader.readStringView();
+			else if (key == "Timestamp") ev.Timestamp = reader.readNumber(0.0);
+			else if (key == "Value") {
+				ev.ValueOffset = reader.position();
+				reader.skip();
+			}
+		});
+		return ev;
+	}
+};
+
 template<Events T>
 class ServerEvent
 {
 public:
-	nlohmann::json json;
 	typename Event<T>::EventValue Value;
-	std::string ContractSessionId;
-	std::string ContractId;
-	std::string Name;
+	// Views into the event text, only valid for the duration of the handler call.
+	std::string_view ContractSessionId;
+	std::string_view ContractId;
+	std::string_view Name;
 	double Timestamp = 0;
+	std::string_view Raw;
 
 public:
 	ServerEvent(typename Event<T>::EventValue&& value) : Value(std::forward<typename Event<T>::EventValue>(value))
 	{ }
-};
-
-extern std::unordered_set<std::string> eventNameBlacklist;
-
-class EventListenersBase
-{
-protected:
-	auto virtual call(const nlohmann::json& ev) const -> bool = 0;
 
-public:
-	auto operator()(const nlohmann::json& ev) const -> bool {
-		return this->call(ev);
+	// Parses the full event text on first use. Handlers should prefer Value.
+	auto json() const -> const nlohmann::json& {
+		if (!this->parsedJson) this->parsedJson = parseJsonText(this->Raw);
+		return *this->parsedJson;
 	}
 
-	auto handle(const nlohmann::json& ev) const -> bool {
-		return this->call(ev);
-	}
+private:
+	mutable std::optional<nlohmann::json> parsedJson;
 };
 
-template<Events TEvent>
-class EventListeners : public EventListenersBase
-{
-public:
-	using HandlerFunc = void(const ServerEvent<TEvent>&);
-
-	EventListeners()
-	{ }
-
-	template<typename TFunc>
-	auto add(TFunc&& func) -> void {
-		this->handlers.emplace_back(std::forward<TFunc>(func));
-	}
+enum class EventNameType : uint8_t {
+	Unknown,
+	Event,
+	Blacklisted,
+};
 
-protected:
-	auto call(const nlohmann::json& ev) const -> bool {
-		auto it = ev.find("Value");
-		if (it == ev.end()) return false;
+struct EventNameEntry
+{
+	std::string_view name;
+	EventNameType type = EventNameType::Unknown;
+	Events event = Events::_Count;
+};
 
-		ServerEvent<TEvent> serverEvent{typename Event<TEvent>::EventValue(*it)};
-		serverEvent.json  = ev;
-		serverEvent.Name = ev.value("Name", "");
-		serverEvent.ContractId = ev.value("ContractId", "");
-		serverEvent.ContractSessionId = ev.value("ContractSessionId", "");
-		serverEvent.Timestamp = ev.value("Timestamp", 0);
+// Finds an event name in a perfect hash table of all event names and blacklisted names, generated at compile time.
+auto lookupEventName(std::string_view name) -> const EventNameEntry&;
 
-		for (auto& handler : this->handlers)
-			handler(serverEvent);
+template<Events TEvent>
+using EventHandler = InlineDelegate<void(const ServerEvent<TEvent>&)>;
 
-		return this->handlers.size() > 0;
-	}
+template<typename>
+struct EventHandlerListsHelper;
 
-private:
-	std::vector<std::function<HandlerFunc>> handlers;
+template<size_t... Indices>
+struct EventHandlerListsHelper<std::index_sequence<Indices...>>
+{
+	using Type = std::tuple<std::vector<EventHandler<static_cast<Events>(Indices)>>...>;
 };
 
+// One handler list per event, indexed by the Events value.
+using EventHandlerLists = EventHandlerListsHelper<std::make_index_sequence<std::to_underlying(Events::_Count)>>::Type;
+
 class EventSystem {
 public:
-	template<Events TEvent>
-	auto listen(std::function<void(const ServerEvent<TEvent>&)> handler) {
-		auto eventNameIt = this->eventNames.find(TEvent);
-		if (eventNameIt == this->eventNames.end())
-			eventNameIt = this->eventNames.emplace(TEvent, Event<TEvent>::Name).first;
-		
-		auto it = this->listeners.find(eventNameIt->second);
-		if (it == this->listeners.end())
-			it = this->listeners.emplace(eventNameIt->second, std::make_unique<EventListeners<TEvent>>()).first;
-		static_cast<EventListeners<TEvent>*>(it->second.get())->add(handler);
-	}
-
-	auto handle(const std::string& str, const nlohmann::json& json) -> bool {
-		auto listeners = this->findListeners(str);
-		if (listeners) return listeners->handle(json);
-		return false;
-	}
-
-	auto handle(Events ev, const nlohmann::json& json) {
-		auto listeners = this->findListeners(ev);
-		if (listeners) return listeners->handle(json);
-		return false;
+	template<Events TEvent, typename TFunc>
+	auto listen(TFunc&& handler) -> void {
+		this->getHandlers<TEvent>().emplace_back(std::forward<TFunc>(handler));
 	}
 
-	auto getEventName(Events ev) -> const std::string* {
-		auto it = this->eventNames.find(ev);
-		if (it != this->eventNames.end())
-			return &it->second;
-		return nullptr;
+	template<Events TEvent>
+	auto getHandlers() -> std::vector<EventHandler<TEvent>>& {
+		return std::get<std::to_underlying(TEvent)>(this->handlers);
 	}
 
-private:
-	auto findListeners(Events ev) -> EventListenersBase* {
-		auto name = this->getEventName(ev);
-		if (name) return this->findListeners(*name);
-		return nullptr;
+	template<Events TEvent>
+	auto getHandlers() const -> const std::vector<EventHandler<TEvent>>& {
+		return std::get<std::to_underlying(TEvent)>(this->handlers);
 	}
 
-	auto findListeners(const std::string& name) -> EventListenersBase* {
-		auto it = this->listeners.find(name);
-		if (it != this->listeners.end())
-			return it->second.get();
-		return nullptr;
-	}
+	auto handle(const RawEvent& ev) const -> bool;
+	auto handle(Events ev, const RawEvent& raw) const -> bool;
 
 private:
-	std::unordered_map<Events, std::string> eventNames;
-	std::unordered_map<std::string, std::unique_ptr<EventListenersBase>> listeners;
+	EventHandlerLists handlers;
 };
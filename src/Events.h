@@ -8,6 +8,7 @@
 #include "json.hpp"
 #include "Enums.h"
 #include "EventSystem.h"
+#include "JsonReader.h"
 
 struct GameChanger {
 	//std::string Id;
@@ -31,100 +32,114 @@ struct LoadoutItemEventValue {
 };
 
 struct DamageHistoryEventValue {
-	bool Explosive;
-	bool Headshot;
-	bool Accident;
-	bool WeaponSilenced;
-	bool Projectile;
-	bool Sniper;
-	bool ThroughWall;
+	bool Explosive = false;
+	bool Headshot = false;
+	bool Accident = false;
+	bool WeaponSilenced = false;
+	bool Projectile = false;
+	bool Sniper = false;
+	bool ThroughWall = false;
 	std::string InstanceId;
 	std::string RepositoryId;
-	int BodyPartId;
-	int TotalDamage;
-
-	DamageHistoryEventValue(const nlohmann::json& json) :
-		Explosive(json.value("Explosive", false)),
-		Headshot(json.value("Headshot", false)),
-		Accident(json.value("Accident", false)),
-		WeaponSilenced(json.value("WeaponSilenced", false)),
-		Projectile(json.value("Projectile", false)),
-		Sniper(json.value("Sniper", false)),
-		ThroughWall(json.value("ThroughWall", false)),
-		InstanceId(json.value("InstanceId", "")),
-		RepositoryId(json.value("RepositoryId", "")),
-		BodyPartId(json.value("BodyPartId", 0)),
-		TotalDamage(json.value("TotalDamage", 0))
-	{ }
+	int BodyPartId = 0;
+	int TotalDamage = 0;
+
+	DamageHistoryEventValue(JsonReader& reader) {
+		reader.readObject([this](std::string_view key, JsonReader& reader) {
+			if (key == "Explosive") this->Explosive = reader.readBool();
+			else if (key == "Headshot") this->Headshot = reader.readBool();
+			else if (key == "Accident") this->Accident = reader.readBool();
+			else if (key == "WeaponSilenced") this->WeaponSilenced = reader.readBool();
+			else if (key == "Projectile") this->Projectile = reader.readBool();
+			else if (key == "Sniper") this->Sniper = reader.readBool();
+			else if (key == "ThroughWall") this->ThroughWall = reader.readBool();
+			else if (key == "InstanceId") this->InstanceId = reader.readString();
+			else if (key == "RepositoryId") this->RepositoryId = reader.readString();
+			else if (key == "BodyPartId") this->BodyPartId = reader.readNumber(0);
+			else if (key == "TotalDamage") this->TotalDamage = reader.readNumber(0);
+		});
+	}
 };
 
 struct PacifyEventValue {
 	std::string RepositoryId;
-	uint32_t ActorId;
+	uint32_t ActorId = 0;
 	std::string ActorName;
-	EActorType ActorType;
-	EKillType KillType;
-	EDeathContext KillContext;
+	EActorType ActorType = getActorTypeFromValue(0);
+	EKillType KillType = getKillTypeFromValue(0);
+	EDeathContext KillContext = getDeathContextFromValue(0);
 	std::string KillClass;
-	bool Accident;
-	bool WeaponSilenced;
-	bool Explosive;
-	int ExplosionType;
-	bool Projectile;
-	bool Sniper;
-	bool IsHeadshot;
-	bool IsTarget;
-	bool ThroughWall;
-	int BodyPartId;
-	double TotalDamage;
-	bool IsMoving;
-	int RoomId;
+	bool Accident = false;
+	bool WeaponSilenced = false;
+	bool Explosive = false;
+	int ExplosionType = 0;
+	bool Projectile = false;
+	bool Sniper = false;
+	bool IsHeadshot = false;
+	bool IsTarget = false;
+	bool ThroughWall = false;
+	int BodyPartId = -1;
+	double TotalDamage = 0;
+	bool IsMoving = false;
+	int RoomId = -1;
 	std::string ActorPosition;
 	std::string HeroPosition;
 	std::vector<std::string> DamageEvents;
-	int PlayerId;
+	int PlayerId = -1;
 	std::string OutfitRepositoryId;
-	bool OutfitIsHitmanSuit;
+	bool OutfitIsHitmanSuit = false;
 	std::string KillMethodBroad;
 	std::string KillMethodStrict;
-	int EvergreenRarity;
+	int EvergreenRarity = -1;
 	std::vector<DamageHistoryEventValue> History;
 
-	PacifyEventValue(const nlohmann::json& json) :
-		RepositoryId(json.value("RepositoryId", "")),
-		ActorId(json.value("ActorId", 0)),
-		ActorName(json.value("ActorName", "")),
-		ActorType(getActorTypeFromValue(json.value("ActorType", 0))),
-		KillType(getKillTypeFromValue(json.value("KillType", 0))),
-		KillContext(getDeathContextFromValue(json.value("KillContext", 0))),
-		KillClass(json.value("KillClass", "")),
-		Accident(json.value("Accident", false)),
-		WeaponSilenced(json.value("WeaponSilenced", false)),
-		Explosive(json.value("Explosive", false)),
-		ExplosionType(json.value("ExplosionType", 0)),
-		Projectile(json.value("Projectile", false)),
-		Sniper(json.value("Sniper", false)),
-		IsHeadshot(json.value("IsHeadshot", false)),
-		IsTarget(json.value("IsTarget", false)),
-		ThroughWall(json.value("ThroughWall", false)),
-		BodyPartId(json.value("BodyPartId", -1)),
-		TotalDamage(json.value("TotalDamage", 0)),
-		IsMoving(json.value("IsMoving", false)),
-		RoomId(json.value("RoomId", -1)),
-		ActorPosition(json.value("ActorPosition", "")),
-		HeroPosition(json.value("HeroPosition", "")),
-		DamageEvents(json["DamageEvents"].get<std::vector<std::string>>()),
-		PlayerId(json.value("PlayerId", -1)),
-		OutfitRepositoryId(json.value("OutfitRepositoryId", "")),
-		OutfitIsHitmanSuit(json.value("OutfitIsHitmanSuit", false)),
-		KillMethodBroad(json.value("KillMethodBroad", "")),
-		KillMethodStrict(json.value("KillMethodStrict", "")),
-		EvergreenRarity(json.value("EvergreenRarity", -1))
-	{
-		auto& history = json["History"];
-		if (history.is_array()) {
-			for (auto& historyIt : history)
-				this->History.emplace_back(historyIt);
+	PacifyEventValue(JsonReader& reader) {
+		reader.readObject([this](std::string_view key, JsonReader& reader) {
+			this->readMember(key, reader);
+		});
+	}
+
+protected:
+	PacifyEventValue() = default;
+
+	auto readMember(std::string_view key, JsonReader& reader) -> void {
+		if (key == "RepositoryId") this->RepositoryId = reader.readString();
+		else if (key == "ActorId") this->ActorId = reader.readNumber<uint32_t>();
+		else if (key == "ActorName") this->ActorName = reader.readString();
+		else if (key == "ActorType") this->ActorType = getActorTypeFromValue(reader.readNumber(0));
+		else if (key == "KillType") this->KillType = getKillTypeFromValue(reader.readNumber(0));
+		else if (key == "KillContext") this->KillContext = getDeathContextFromValue(reader.readNumber(0));
+		else if (key == "KillClass") this->KillClass = reader.readString();
+		else if (key == "Accident") this->Accident = reader.readBool();
+		else if (key == "WeaponSilenced") this->WeaponSilenced = reader.readBool();
+		else if (key == "Explosive") this->Explosive = reader.readBool();
+		else if (key == "ExplosionType") this->ExplosionType = reader.readNumber(0);
+		else if (key == "Projectile") this->Projectile = reader.readBool();
+		else if (key == "Sniper") this->Sniper = reader.readBool();
+		else if (key == "IsHeadshot") this->IsHeadshot = reader.readBool();
+		else if (key == "IsTarget") this->IsTarget = reader.readBool();
+		else if (key == "ThroughWall") this->ThroughWall = reader.readBool();
+		else if (key == "BodyPartId") this->BodyPartId = reader.readNumber(-1);
+		else if (key == "TotalDamage") this->TotalDamage = reader.readNumber(0.0);
+		else if (key == "IsMoving") this->IsMoving = reader.readBool();
+		else if (key == "RoomId") this->RoomId = reader.readNumber(-1);
+		else if (key == "ActorPosition") this->ActorPosition = reader.readString();
+		else if (key == "HeroPosition") this->HeroPosition = reader.readString();
+		else if (key == "PlayerId") this->PlayerId = reader.readNumber(-1);
+		else if (key == "OutfitRepositoryId") this->OutfitRepositoryId = reader.readString();
+		else if (key == "OutfitIsHitmanSuit") this->OutfitIsHitmanSuit = reader.readBool();
+		else if (key == "KillMethodBroad") this->KillMethodBroad = reader.readString();
+		else if (key == "KillMethodStrict") this->KillMethodStrict = reader.readString();
+		else if (key == "EvergreenRarity") this->EvergreenRarity = reader.readNumber(-1);
+		else if (key == "DamageEvents") {
+			reader.readArray([this](JsonReader& reader) {
+				this->DamageEvents.emplace_back(reader.readString());
+			});
+		}
+		else if (key == "History") {
+			reader.readArray([this](JsonReader& reader) {
+				this->History.emplace_back(reader);
+			});
 		}
 	}
 };
@@ -133,71 +148,94 @@ struct KillEventValue : PacifyEventValue {
 	std::string KillItemRepositoryId;
 	std::string KillItemInstanceId;
 	std::string KillItemCategory;
+
+	KillEventValue(JsonReader& reader) {
+		reader.readObject([this](std::string_view key, JsonReader& reader) {
+			if (key == "KillItemRepositoryId") this->KillItemRepositoryId = reader.readString();
+			else if (key == "KillItemInstanceId") this->KillItemInstanceId = reader.readString();
+			else if (key == "KillItemCategory") this->KillItemCategory = reader.readString();
+			else this->readMember(key, reader);
+		});
+	}
 };
 
 struct VoidEventValue {
-	VoidEventValue(const nlohmann::json& json) {}
+	VoidEventValue(JsonReader& reader) {}
 };
 
 struct StringEventValue {
 	std::string value;
 
-	StringEventValue(const nlohmann::json& json) : value(json.get<std::string>())
+	StringEventValue(JsonReader& reader) : value(reader.readString())
 	{ }
 };
 
 struct StringArrayEventValue {
 	std::vector<std::string> value;
 
-	StringArrayEventValue(const nlohmann::json& json) {
-		if (!json.is_array()) return;
-		for (auto& v : json) {
-			this->value.emplace_back(v.get<std::string>());
-		}
+	StringArrayEventValue(JsonReader& reader) {
+		reader.readArray([this](JsonReader& reader) {
+			this->value.emplace_back(reader.readString());
+		});
 	}
 };
 
 struct TakedownCleannessEventValue {
 	std::string RepositoryId;
-	bool IsTarget;
+	bool IsTarget = false;
 
-	TakedownCleannessEventValue(const nlohmann::json& json) :
-		RepositoryId(json.value("RepositoryId", "")),
-		IsTarget(json.value("IsTarget", false))
-	{ }
+	TakedownCleannessEventValue(JsonReader& reader) {
+		reader.readObject([this](std::string_view key, JsonReader& reader) {
+			if (key == "RepositoryId") this->RepositoryId = reader.readString();
+			else if (key == "IsTarget") this->IsTarget = reader.readBool();
+		});
+	}
 };
 
 struct ActorIdentityEventValue {
-	unsigned ActorId;
+	unsigned ActorId = 0;
 	std::string RepositoryId;
 	std::string ActorName;
 
-	ActorIdentityEventValue(const nlohmann::json& json) :
-		ActorId(json.value("ActorId", 0)),
-		RepositoryId(json.value("RepositoryId", "")),
-		ActorName(json.value("ActorName", ""))
-	{ }
+	ActorIdentityEventValue(JsonReader& reader) {
+		reader.readObject([this](std::string_view key, JsonReader& reader) {
+			if (key == "ActorId") this->ActorId = reader.readNumber<unsigned>();
+			else if (key == "RepositoryId") this->RepositoryId = reader.readString();
+			else if (key == "ActorName") this->ActorName = reader.readString();
+		});
+	}
 };
 
 struct BodyEventValue {
 	std::string RepositoryId;
-	bool IsCrowdActor;
+	bool IsCrowdActor = false;
 
-	BodyEventValue(const nlohmann::json& json) :
-		RepositoryId(json.value("RepositoryId", "")),
-		IsCrowdActor(json.value("IsCrowdActor", false))
-	{ }
+	BodyEventValue() = default;
+	BodyEventValue(JsonReader& reader) {
+		reader.readObject([this](std::string_view key, JsonReader& reader) {
+			this->readMember(key, reader);
+		});
+	}
+
+protected:
+	auto readMember(std::string_view key, JsonReader& reader) -> void {
+		if (key == "RepositoryId") this->RepositoryId = reader.readString();
+		else if (key == "IsCrowdActor") this->IsCrowdActor = reader.readBool();
+	}
 };
 
 struct BodyKillInfoEventValue : BodyEventValue {
-	EDeathContext DeathContext;
-	EDeathType DeathType;
-
-	BodyKillInfoEventValue(const nlohmann::json& json) :
-		BodyEventValue(json),
-		DeathContext(getDeathContextFromValue(json.value("DeathContext", 0))),
-		DeathType(getDeathTypeFromValue(json.value("DeathType", 0)))
-	{ }
+	EDeathContext DeathContext = getDeathContextFromValue(0);
+	EDeathType DeathType = getDeathTypeFromValue(0);
+
+	BodyKillInfoEventValue() = default;
+	BodyKillInfoEventValue(JsonReader& reader) {
+		reader.readObject([this](std::string_view key, JsonReader& reader) {
+			if (key == "DeathContext") this->DeathContext = getDeathContextFromValue(reader.readNumber(0));
+			else if (key == "DeathType") this->DeathType = getDeathTypeFromValue(reader.readNumber(0));
+			else this->readMember(key, reader);
+		});
+	}
 };
 
 struct ItemEventValue {
@@ -207,10 +245,12 @@ struct ItemEventValue {
 	//std::vector<std::string> OnlineTraits;
 	//std::string ActionRewardType;
 
-	ItemEventValue(const nlohmann::json& json) {
-		ItemName = json.value("ItemName", "");
-		ItemType = json.value("ItemType", "");
-		RepositoryId = json.value("RepositoryId", "");
+	ItemEventValue(JsonReader& reader) {
+		reader.readObject([this](std::string_view key, JsonReader& reader) {
+			if (key == "ItemName") this->ItemName = reader.readString();
+			else if (key == "ItemType") this->ItemType = reader.readString();
+			else if (key == "RepositoryId") this->RepositoryId = reader.readString();
+		});
 	}
 };
 
@@ -222,35 +262,42 @@ struct Event<Events::ContractStart> {
 		std::vector<LoadoutItemEventValue> Loadout;
 		std::string Disguise;
 		std::string LocationId;
-		MissionType ContractType;
+		MissionType ContractType = MissionType::Unknown;
 		std::vector<GameChanger> GameChangers;
-		int DifficultyLevel;
-		bool IsVR;
-		bool IsHitmanSuit;
+		int DifficultyLevel = -1;
+		bool IsVR = false;
+		bool IsHitmanSuit = false;
 		std::string SelectedCharacterId;
-		int EvergreenSeed;
-		int EvergreenDifficulty;
-
-		EventValue(const nlohmann::json& value) {
-			auto& loadout = value["Loadout"];
-			for (auto const& ld : loadout)
-			{
-				LoadoutItemEventValue loadoutItem;
-				loadoutItem.RepositoryId = ld.value("RepositoryId", "");
-				loadoutItem.InstanceId = ld.value("RepositoryId", "");
-				loadoutItem.OnlineTraits = ld["OnlineTraits"].get<std::vector<std::string>>();
-				loadoutItem.Category = nullptr;
-				Loadout.emplace_back(loadoutItem);
-			}
-			Disguise = value.value("Disguise", "");
-			LocationId = value.value("LocationId", "");
-			ContractType = getMissionTypeFromString(value.value("ContractType", "")).value_or(MissionType::Unknown);
-			DifficultyLevel = value.value<int>("DifficultyLevel", -1);
-			IsVR = value.value<bool>("IsVR", false);
-			IsHitmanSuit = value.value<bool>("IsHitmanSuit", false);
-			SelectedCharacterId = value.value("SelectedCharacterId", "");
-			EvergreenSeed = value.value("EvergreenSeed", 0);
-			EvergreenDifficulty = value.value("EvergreenDifficulty", 0);
+		int EvergreenSeed = 0;
+		int EvergreenDifficulty = 0;
+
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "Loadout") {
+					reader.readArray([this](JsonReader& reader) {
+						auto& loadoutItem = this->Loadout.emplace_back();
+						loadoutItem.Category = nullptr;
+						reader.readObject([&loadoutItem](std::string_view key, JsonReader& reader) {
+							if (key == "RepositoryId") loadoutItem.RepositoryId = reader.readString();
+							else if (key == "InstanceId") loadoutItem.InstanceId = reader.readString();
+							else if (key == "OnlineTraits") {
+								reader.readArray([&loadoutItem](JsonReader& reader) {
+									loadoutItem.OnlineTraits.emplace_back(reader.readString());
+								});
+							}
+						});
+					});
+				}
+				else if (key == "Disguise") this->Disguise = reader.readString();
+				else if (key == "LocationId") this->LocationId = reader.readString();
+				else if (key == "ContractType") this->ContractType = getMissionTypeFromString(reader.readString()).value_or(MissionType::Unknown);
+				else if (key == "DifficultyLevel") this->DifficultyLevel = reader.readNumber(-1);
+				else if (key == "IsVR") this->IsVR = reader.readBool();
+				else if (key == "IsHitmanSuit") this->IsHitmanSuit = reader.readBool();
+				else if (key == "SelectedCharacterId") this->SelectedCharacterId = reader.readString();
+				else if (key == "EvergreenSeed") this->EvergreenSeed = reader.readNumber(0);
+				else if (key == "EvergreenDifficulty") this->EvergreenDifficulty = reader.readNumber(0);
+			});
 		}
 	};
 };
@@ -286,15 +333,19 @@ struct Event<Events::setpieces> {
 		std::string Item_triggered_metricvalue;
 		SVector3 Position;
 
-		EventValue(const nlohmann::json& json) :
-			RepositoryId(json.value("RepositoryId", "")),
-			name_metricvalue(json.value("name_metricvalue", "")),
-			setpieceHelper_metricvalue(json.value("setpieceHelper_metricvalue", "")),
-			setpieceType_metricvalue(json.value("setpieceType_metricvalue", "")),
-			toolUsed_metricvalue(json.value("toolUsed_metricvalue", "")),
-			Item_triggered_metricvalue(json.value("Item_triggered_metricvalue", "")),
-			Position(json.value("x", 0.0), json.value("y", 0.0), json.value("z", 0.0))
-		{ }
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "RepositoryId") this->RepositoryId = reader.readString();
+				else if (key == "name_metricvalue") this->name_metricvalue = reader.readString();
+				else if (key == "setpieceHelper_metricvalue") this->setpieceHelper_metricvalue = reader.readString();
+				else if (key == "setpieceType_metricvalue") this->setpieceType_metricvalue = reader.readString();
+				else if (key == "toolUsed_metricvalue") this->toolUsed_metricvalue = reader.readString();
+				else if (key == "Item_triggered_metricvalue") this->Item_triggered_metricvalue = reader.readString();
+				else if (key == "x") this->Position.x = reader.readNumber(0.0f);
+				else if (key == "y") this->Position.y = reader.readNumber(0.0f);
+				else if (key == "z") this->Position.z = reader.readNumber(0.0f);
+			});
+		}
 	};
 };
 
@@ -304,8 +355,10 @@ struct Event<Events::AddSyndicateTarget> {
 	struct EventValue {
 		std::string repoID;
 
-		EventValue(const nlohmann::json& json) {
-			repoID = json.value("repoID", "");
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "repoID") this->repoID = reader.readString();
+			});
 		}
 	};
 };
@@ -340,6 +393,12 @@ struct Event<Events::ItemThrown> {
 	using EventValue = ItemEventValue;
 };
 
+template<>
+struct Event<Events::ItemDestroyed> {
+	static auto constexpr Name = "ItemDestroyed";
+	using EventValue = ItemEventValue;
+};
+
 template<>
 struct Event<Events::Disguise> {
 	static auto constexpr Name = "Disguise";
@@ -357,24 +416,28 @@ struct Event<Events::Actorsick> {
 	static auto constexpr Name = "Actorsick";
 	struct EventValue {
 		SVector3 ActorPosition;
-		unsigned ActorId;
+		unsigned ActorId = 0;
 		std::string ActorName;
 		std::string actor_R_ID;
-		bool IsTarget;
+		bool IsTarget = false;
 		std::string item_R_ID;
 		std::string setpiece_R_ID;
-		EActorType ActorType;
-
-		EventValue(const nlohmann::json& json) :
-			ActorPosition(json.value("x", 0.0), json.value("y", 0.0), json.value("z", 0.0)),
-			ActorId(json.value("ActorId", 0)),
-			ActorName(json.value("ActorName", "")),
-			actor_R_ID(json.value("actor_R_ID", "")),
-			IsTarget(json.value("IsTarget", false)),
-			item_R_ID(json.value("item_R_ID", "")),
-			setpiece_R_ID(json.value("setpiece_R_ID", "")),
-			ActorType(getActorTypeFromValue(json.value("ActorType", -1)))
-		{ }
+		EActorType ActorType = getActorTypeFromValue(-1);
+
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "x") this->ActorPosition.x = reader.readNumber(0.0f);
+				else if (key == "y") this->ActorPosition.y = reader.readNumber(0.0f);
+				else if (key == "z") this->ActorPosition.z = reader.readNumber(0.0f);
+				else if (key == "ActorId") this->ActorId = reader.readNumber<unsigned>();
+				else if (key == "ActorName") this->ActorName = reader.readString();
+				else if (key == "actor_R_ID") this->actor_R_ID = reader.readString();
+				else if (key == "IsTarget") this->IsTarget = reader.readBool();
+				else if (key == "item_R_ID") this->item_R_ID = reader.readString();
+				else if (key == "setpiece_R_ID") this->setpiece_R_ID = reader.readString();
+				else if (key == "ActorType") this->ActorType = getActorTypeFromValue(reader.readNumber(-1));
+			});
+		}
 	};
 };
 
@@ -383,20 +446,22 @@ struct Event<Events::Dart_Hit> {
 	static auto constexpr Name = "Dart_Hit";
 	struct EventValue {
 		std::string RepositoryId;
-		EActorType ActorType;
-		bool IsTarget;
-		bool Blind;
-		bool Sedative;
-		bool Sick;
-
-		EventValue(const nlohmann::json& json) :
-			RepositoryId(json.value("RepositoryId", "")),
-			ActorType(getActorTypeFromValue(json.value("ActorType", -1))),
-			IsTarget(json.value("IsTarget", false)),
-			Blind(json.find("Blind") != json.end()),
-			Sedative(json.find("Sedative") != json.end()),
-			Sick(json.find("Sick") != json.end())
-		{ }
+		EActorType ActorType = getActorTypeFromValue(-1);
+		bool IsTarget = false;
+		bool Blind = false;
+		bool Sedative = false;
+		bool Sick = false;
+
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "RepositoryId") this->RepositoryId = reader.readString();
+				else if (key == "ActorType") this->ActorType = getActorTypeFromValue(reader.readNumber(-1));
+				else if (key == "IsTarget") this->IsTarget = reader.readBool();
+				else if (key == "Blind") this->Blind = true;
+				else if (key == "Sedative") this->Sedative = true;
+				else if (key == "Sick") this->Sick = true;
+			});
+		}
 	};
 };
 
@@ -404,13 +469,15 @@ template<>
 struct Event<Events::Trespassing> {
 	static auto constexpr Name = "Trespassing";
 	struct EventValue {
-		bool IsTrespassing;
-		int RoomId;
-
-		EventValue(const nlohmann::json& json) :
-			IsTrespassing(json.value("IsTrespassing", false)),
-			RoomId(json.value("RoomId", -1))
-		{ }
+		bool IsTrespassing = false;
+		int RoomId = -1;
+
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "IsTrespassing") this->IsTrespassing = reader.readBool();
+				else if (key == "RoomId") this->RoomId = reader.readNumber(-1);
+			});
+		}
 	};
 };
 
@@ -418,15 +485,17 @@ template<>
 struct Event<Events::SecuritySystemRecorder> {
 	static auto constexpr Name = "SecuritySystemRecorder";
 	struct EventValue {
-		SecuritySystemRecorderEvent event;
-		unsigned camera;
-		unsigned recorder;
-
-		EventValue(const nlohmann::json& json) :
-			event(getSecuritySystemRecorderEventFromString(json.value("event", ""))),
-			camera(json.value("camera", 0)),
-			recorder(json.value("recorder", 0))
-		{ }
+		SecuritySystemRecorderEvent event = SecuritySystemRecorderEvent::Undefined;
+		unsigned camera = 0;
+		unsigned recorder = 0;
+
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "event") this->event = getSecuritySystemRecorderEventFromString(reader.readString());
+				else if (key == "camera") this->camera = reader.readNumber<unsigned>();
+				else if (key == "recorder") this->recorder = reader.readNumber<unsigned>();
+			});
+		}
 	};
 };
 
@@ -454,8 +523,11 @@ struct Event<Events::AccidentBodyFound> {
 	struct EventValue {
 		BodyKillInfoEventValue DeadBody;
 
-		EventValue(const nlohmann::json& json) : DeadBody(json["DeadBody"])
-		{}
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "DeadBody") this->DeadBody = BodyKillInfoEventValue(reader);
+			});
+		}
 	};
 };
 
@@ -465,8 +537,11 @@ struct Event<Events::BodyFound> {
 	struct EventValue {
 		BodyKillInfoEventValue DeadBody;
 
-		EventValue(const nlohmann::json& json) : DeadBody(json["DeadBody"])
-		{}
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "DeadBody") this->DeadBody = BodyKillInfoEventValue(reader);
+			});
+		}
 	};
 };
 
@@ -482,12 +557,15 @@ struct Event<Events::MurderedBodySeen> {
 	struct EventValue {
 		BodyEventValue DeadBody;
 		std::string Witness;
-		bool IsWitnessTarget;
-
-		EventValue(const nlohmann::json& json) : DeadBody(json["DeadBody"]),
-			Witness(json.value("Witness", "")),
-			IsWitnessTarget(json.value("IsWitnessTarget", false))
-		{}
+		bool IsWitnessTarget = false;
+
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "DeadBody") this->DeadBody = BodyEventValue(reader);
+				else if (key == "Witness") this->Witness = reader.readString();
+				else if (key == "IsWitnessTarget") this->IsWitnessTarget = reader.readBool();
+			});
+		}
 	};
 };
 
@@ -555,12 +633,15 @@ template<>
 struct Event<Events::ShotsFired> {
 	static auto constexpr Name = "ShotsFired";
 	struct EventValue {
-		int Split;
-		int Total;
-
-		EventValue(const nlohmann::json& json) : Split(json["Split"].value("", 0)),
-			Total(json.value("Total", 0))
-		{}
+		int Split = 0;
+		int Total = 0;
+
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "Split") this->Split = reader.readNumber(0);
+				else if (key == "Total") this->Total = reader.readNumber(0);
+			});
+		}
 	};
 };
 
@@ -582,6 +663,12 @@ struct Event<Events::TargetEliminated> {
 	using EventValue = VoidEventValue;
 };
 
+template<>
+struct Event<Events::TargetEscapeFoiled> {
+	static auto constexpr Name = "TargetEscapeFoiled";
+	using EventValue = VoidEventValue;
+};
+
 template<>
 struct Event<Events::_47_FoundTrespassing> {
 	static auto constexpr Name = "47_FoundTrespassing";
@@ -616,17 +703,19 @@ template<>
 struct Event<Events::AmbientChanged> {
 	static auto constexpr Name = "AmbientChanged";
 	struct EventValue {
-		EGameTension PreviousAmbientValue;
-		EGameTension AmbientValue;
+		EGameTension PreviousAmbientValue = getGameTensionFromValue(0);
+		EGameTension AmbientValue = getGameTensionFromValue(0);
 		//std::string PreviousAmbient;
 		//std::string Ambient;
 
-		EventValue(const nlohmann::json& json) :
-			PreviousAmbientValue(getGameTensionFromValue(json.value("PreviousAmbientValue", 0))),
-			AmbientValue(getGameTensionFromValue(json.value("PreviousAmbientValue", 0)))
-			//PreviousAmbient(json.value("PreviousAmbient", "")),
-			//Ambient(json.value("Ambient", "")),
-		{}
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "PreviousAmbientValue") this->PreviousAmbientValue = getGameTensionFromValue(reader.readNumber(0));
+				else if (key == "AmbientValue") this->AmbientValue = getGameTensionFromValue(reader.readNumber(0));
+				//else if (key == "PreviousAmbient") this->PreviousAmbient = reader.readString();
+				//else if (key == "Ambient") this->Ambient = reader.readString();
+			});
+		}
 	};
 };
 
@@ -634,11 +723,13 @@ template<>
 struct Event<Events::HoldingIllegalWeapon> {
 	static auto constexpr Name = "HoldingIllegalWeapon";
 	struct EventValue {
-		bool IsHoldingIllegalWeapon;
+		bool IsHoldingIllegalWeapon = false;
 
-		EventValue(const nlohmann::json& json) :
-			IsHoldingIllegalWeapon(json.value("IsHoldingIllegalWeapon", false))
-		{}
+		EventValue(JsonReader& reader) {
+			reader.readObject([this](std::string_view key, JsonReader& reader) {
+				if (key == "IsHoldingIllegalWeapon") this->IsHoldingIllegalWeapon = reader.readBool();
+			});
+		}
 	};
 };
 
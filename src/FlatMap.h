@@ -0,0 +1,100 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include "SmallVector.h"
+
+// Map stored as a sorted contiguous array of key/value pairs, with room for InlineCapacity entries before it allocates.
+// Cheap to iterate and clear, but inserts and erases are O(n), so only suited to small maps.
+template<typename TKey, typename TValue, size_t InlineCapacity = 16, typename Compare = std::less<TKey>>
+class FlatMap
+{
+public:
+	using key_type = TKey;
+	using mapped_type = TValue;
+	using value_type = std::pair<TKey, TValue>;
+	using size_type = size_t;
+	using iterator = typename SmallVector<value_type, InlineCapacity>::iterator;
+	using const_iterator = typename SmallVector<value_type, InlineCapacity>::const_iterator;
+	using allocator_type = typename SmallVector<value_type, InlineCapacity>::allocator_type;
+
+	FlatMap() = default;
+
+	explicit FlatMap(const allocator_type& alloc) : items(alloc)
+	{}
+
+	FlatMap(const FlatMap& other, const allocator_type& alloc) : items(other.items, alloc)
+	{}
+
+	FlatMap(FlatMap&& other, const allocator_type& alloc) : items(std::move(other.items), alloc)
+	{}
+
+	FlatMap(const FlatMap&) = default;
+	FlatMap(FlatMap&&) = default;
+	auto operator=(const FlatMap&) -> FlatMap& = default;
+	auto operator=(FlatMap&&) -> FlatMap& = default;
+
+	auto begin() -> iterator { return this->items.begin(); }
+	auto begin() const -> const_iterator { return this->items.begin(); }
+	auto end() -> iterator { return this->items.end(); }
+	auto end() const -> const_iterator { return this->items.end(); }
+	auto size() const { return this->items.size(); }
+	auto empty() const { return this->items.empty(); }
+	auto clear() -> void { this->items.clear(); }
+
+	auto find(const TKey& key) -> iterator {
+		auto it = this->lowerBound(key);
+		return it != this->end() && !Compare{}(key, it->first) ? it : this->end();
+	}
+
+	auto find(const TKey& key) const -> const_iterator {
+		return const_cast<FlatMap*>(this)->find(key);
+	}
+
+	auto contains(const TKey& key) const -> bool {
+		return this->find(key) != this->end();
+	}
+
+	auto count(const TKey& key) const -> size_t {
+		return this->contains(key) ? 1 : 0;
+	}
+
+	template<typename... TArgs>
+	auto try_emplace(const TKey& key, TArgs&&... args) -> std::pair<iterator, bool> {
+		auto it = this->lowerBound(key);
+		if (it != this->end() && !Compare{}(key, it->first)) return {it, false};
+		it = this->items.emplace(it, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<TArgs>(args)...));
+		return {it, true};
+	}
+
+	template<typename TArg>
+	auto emplace(const TKey& key, TArg&& value) -> std::pair<iterator, bool> {
+		return this->try_emplace(key, std::forward<TArg>(value));
+	}
+
+	auto operator[](const TKey& key) -> TValue& {
+		return this->try_emplace(key).first->second;
+	}
+
+	auto erase(const_iterator it) -> iterator {
+		return this->items.erase(it);
+	}
+
+	auto erase(const TKey& key) -> size_t {
+		auto it = this->find(key);
+		if (it == this->end()) return 0;
+		this->items.erase(it);
+		return 1;
+	}
+
+private:
+	auto lowerBound(const TKey& key) -> iterator {
+		return std::lower_bound(this->items.begin(), this->items.end(), key, [](const value_type& item, const TKey& key) {
+			return Compare{}(item.first, key);
+		});
+	}
+
+private:
+	SmallVector<value_type, InlineCapacity> items;
+};
@@ -0,0 +1,83 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include "SmallVector.h"
+
+// Set stored as a sorted contiguous array, with room for InlineCapacity elements before it allocates.
+// Cheap to iterate and clear, but inserts and erases are O(n), so only suited to small sets.
+template<typename T, size_t InlineCapacity = 16, typename Compare = std::less<T>>
+class FlatSet
+{
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using iterator = typename SmallVector<T, InlineCapacity>::const_iterator;
+	using const_iterator = iterator;
+	using allocator_type = typename SmallVector<T, InlineCapacity>::allocator_type;
+
+	FlatSet() = default;
+
+	explicit FlatSet(const allocator_type& alloc) : items(alloc)
+	{}
+
+	FlatSet(const FlatSet& other, const allocator_type& alloc) : items(other.items, alloc)
+	{}
+
+	FlatSet(FlatSet&& other, const allocator_type& alloc) : items(std::move(other.items), alloc)
+	{}
+
+	FlatSet(const FlatSet&) = default;
+	FlatSet(FlatSet&&) = default;
+	auto operator=(const FlatSet&) -> FlatSet& = default;
+	auto operator=(FlatSet&&) -> FlatSet& = default;
+
+	auto begin() const -> iterator { return this->items.begin(); }
+	auto end() const -> iterator { return this->items.end(); }
+	auto size() const { return this->items.size(); }
+	auto empty() const { return this->items.empty(); }
+	auto clear() -> void { this->items.clear(); }
+
+	auto find(const T& value) const -> iterator {
+		auto it = this->lowerBound(value);
+		return it != this->end() && !Compare{}(value, *it) ? it : this->end();
+	}
+
+	auto contains(const T& value) const -> bool {
+		return this->find(value) != this->end();
+	}
+
+	auto count(const T& value) const -> size_t {
+		return this->contains(value) ? 1 : 0;
+	}
+
+	auto insert(const T& value) -> std::pair<iterator, bool> {
+		auto it = this->lowerBound(value);
+		if (it != this->end() && !Compare{}(value, *it)) return {it, false};
+		return {this->items.emplace(it, value), true};
+	}
+
+	template<typename... TArgs>
+	auto emplace(TArgs&&... args) -> std::pair<iterator, bool> {
+		return this->insert(T(std::forward<TArgs>(args)...));
+	}
+
+	auto erase(iterator it) -> iterator {
+		return this->items.erase(it);
+	}
+
+	auto erase(const T& value) -> size_t {
+		auto it = this->find(value);
+		if (it == this->end()) return 0;
+		this->items.erase(it);
+		return 1;
+	}
+
+private:
+	auto lowerBound(const T& value) const -> iterator {
+		return std::lower_bound(this->items.begin(), this->items.end(), value, Compare{});
+	}
+
+private:
+	SmallVector<T, InlineCapacity> items;
+};
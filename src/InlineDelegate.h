@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename TSignature, size_t Capacity = sizeof(void*) * 4>
+class InlineDelegate;
+
+// Callable wrapper which stores the functor inline, without heap allocation or virtual calls.
+// Only accepts small trivially copyable functors, like lambdas capturing a few pointers.
+template<typename TReturn, typename... TArgs, size_t Capacity>
+class InlineDelegate<TReturn(TArgs...), Capacity>
+{
+public:
+	template<typename TFunc> requires (!std::is_same_v<std::remove_cvref_t<TFunc>, InlineDelegate>)
+	InlineDelegate(TFunc&& func) {
+		using Func = std::remove_cvref_t<TFunc>;
+
+		static_assert(sizeof(Func) <= Capacity, "Functor is too large for InlineDelegate");
+		static_assert(alignof(Func) <= alignof(std::max_align_t), "Functor is over-aligned for InlineDelegate");
+		static_assert(std::is_trivially_copyable_v<Func> && std::is_trivially_destructible_v<Func>, "InlineDelegate functors must be trivially copyable");
+
+		::new (static_cast<void*>(this->storage)) Func(std::forward<TFunc>(func));
+
+		this->invoker = [](const std::byte* storage, TArgs... args) -> TReturn {
+			return (*std::launder(reinterpret_cast<const Func*>(storage)))(std::forward<TArgs>(args)...);
+		};
+	}
+
+	auto operator()(TArgs... args) const -> TReturn {
+		return this->invoker(this->storage, std::forward<TArgs>(args)...);
+	}
+
+private:
+	alignas(std::max_align_t) std::byte storage[Capacity];
+	TReturn(*invoker)(const std::byte*, TArgs...) = nullptr;
+};
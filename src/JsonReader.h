@@ -0,0 +1,347 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "json.hpp"
+
+// Forward iterator over event text which skips newline characters.
+// ZDynamicObject::ToString can emit raw newlines, even inside string values, so they are dropped as the parser
+// reads instead of copying the whole event into a sanitised string first.
+class JsonTextIterator
+{
+public:
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = char;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const char*;
+	using reference = const char&;
+
+	JsonTextIterator() = default;
+	JsonTextIterator(const char* it, const char* end) : it(it), end(end) {
+		this->skipNewlines();
+	}
+
+	auto operator*() const -> reference { return *this->it; }
+
+	auto operator++() -> JsonTextIterator& {
+		++this->it;
+		this->skipNewlines();
+		return *this;
+	}
+
+	auto operator++(int) -> JsonTextIterator {
+		auto copy = *this;
+		++*this;
+		return copy;
+	}
+
+	auto operator==(const JsonTextIterator& other) const -> bool { return this->it == other.it; }
+
+private:
+	auto skipNewlines() -> void {
+		while (this->it != this->end && *this->it == '\n') ++this->it;
+	}
+
+private:
+	const char* it = nullptr;
+	const char* end = nullptr;
+};
+
+inline auto parseJsonText(std::string_view text) -> nlohmann::json {
+	auto const end = text.data() + text.size();
+	return nlohmann::json::parse(JsonTextIterator(text.data(), end), JsonTextIterator(end, end));
+}
+
+// Pull parser for reading event values straight from the event text without building a DOM.
+// Reading a value with the wrong type skips it and returns the given default, similar to nlohmann::json::value.
+class JsonReader
+{
+public:
+	explicit JsonReader(std::string_view text, size_t offset = 0) : text(text), pos(offset)
+	{ }
+
+	auto position() const -> size_t { return this->pos; }
+
+	auto readBool(bool defaultValue = false) -> bool {
+		switch (this->skipWhitespace()) {
+			case 't':
+				this->expectLiteral("true");
+				return true;
+			case 'f':
+				this->expectLiteral("false");
+				return false;
+		}
+		this->skip();
+		return defaultValue;
+	}
+
+	template<typename T>
+	auto readNumber(T defaultValue = {}) -> T {
+		auto c = this->skipWhitespace();
+		if (c != '-' && (c < '0' || c > '9')) {
+			this->skip();
+			return defaultValue;
+		}
+
+		auto const str = this->scanNumber();
+		auto const isFloat = str.find_first_of(".eE") != std::string_view::npos;
+
+		if (std::is_floating_point_v<T> || isFloat) {
+			double value = 0;
+			if (std::from_chars(str.data(), str.data() + str.size(), value).ec != std::errc{}) return defaultValue;
+			if constexpr (std::is_floating_point_v<T>) return static_cast<T>(value);
+			else return static_cast<T>(static_cast<int64_t>(value));
+		}
+		else {
+			int64_t value = 0;
+			if (std::from_chars(str.data(), str.data() + str.size(), value).ec != std::errc{}) return defaultValue;
+			return static_cast<T>(value);
+		}
+	}
+
+	auto readString(std::string defaultValue = {}) -> std::string {
+		if (this->skipWhitespace() != '"') {
+			this->skip();
+			return defaultValue;
+		}
+		return unescape(this->scanString());
+	}
+
+	// Returns the raw contents of a string value, leaving any escape sequences as-is.
+	auto readStringView() -> std::string_view {
+		if (this->skipWhitespace() != '"') {
+			this->skip();
+			return {};
+		}
+		return this->scanString();
+	}
+
+	// Calls func(key, reader) for each member, which should read or skip the member value.
+	template<typename TFunc>
+	auto readObject(TFunc&& func) -> bool {
+		if (this->skipWhitespace() != '{') {
+			this->skip();
+			return false;
+		}
+
+		++this->pos;
+
+		if (this->skipWhitespace() == '}') {
+			++this->pos;
+			return true;
+		}
+
+		while (true) {
+			if (this->skipWhitespace() != '"') this->fail("expected object key");
+			auto const key = this->scanString();
+			this->expect(':');
+
+			auto const valuePos = this->pos;
+			func(key, *this);
+			if (this->pos == valuePos) this->skip();
+
+			auto c = this->skipWhitespace();
+			++this->pos;
+			if (c == '}') break;
+			if (c != ',') this->fail("expected ',' or '}'");
+		}
+		return true;
+	}
+
+	// Calls func(reader) for each element, which should read or skip the element.
+	template<typename TFunc>
+	auto readArray(TFunc&& func) -> bool {
+		if (this->skipWhitespace() != '[') {
+			this->skip();
+			return false;
+		}
+
+		++this->pos;
+
+		if (this->skipWhitespace() == ']') {
+			++this->pos;
+			return true;
+		}
+
+		while (true) {
+			auto const valuePos = this->pos;
+			func(*this);
+			if (this->pos == valuePos) this->skip();
+
+			auto c = this->skipWhitespace();
+			++this->pos;
+			if (c == ']') break;
+			if (c != ',') this->fail("expected ',' or ']'");
+		}
+		return true;
+	}
+
+	auto skip() -> void {
+		switch (this->skipWhitespace()) {
+			case '"':
+				this->scanString();
+				return;
+			case 't':
+				this->expectLiteral("true");
+				return;
+			case 'f':
+				this->expectLiteral("false");
+				return;
+			case 'n':
+				this->expectLiteral("null");
+				return;
+			case '{':
+			case '[': {
+				auto depth = 0;
+				do {
+					switch (this->skipWhitespace()) {
+						case '"':
+							this->scanString();
+							continue;
+						case '{':
+						case '[':
+							++depth;
+							break;
+						case '}':
+						case ']':
+							--depth;
+							break;
+						case '\0':
+							this->fail("unexpected end of input");
+					}
+					++this->pos;
+				} while (depth > 0);
+				return;
+			}
+		}
+		if (this->pos < this->text.size() && (this->text[this->pos] == '-' || (this->text[this->pos] >= '0' && this->text[this->pos] <= '9'))) {
+			this->scanNumber();
+			return;
+		}
+		this->fail("unexpected character");
+	}
+
+	static auto unescape(std::string_view str) -> std::string {
+		if (str.find_first_of("\\\n") == std::string_view::npos)
+			return std::string(str);
+
+		std::string result;
+		result.reserve(str.size());
+
+		for (size_t i = 0; i < str.size(); ++i) {
+			auto c = str[i];
+			if (c == '\n') continue;
+			if (c != '\\' || i + 1 >= str.size()) {
+				result += c;
+				continue;
+			}
+
+			switch (str[++i]) {
+				case 'b': result += '\b'; break;
+				case 'f': result += '\f'; break;
+				case 'n': result += '\n'; break;
+				case 'r': result += '\r'; break;
+				case 't': result += '\t'; break;
+				case 'u': {
+					auto codepoint = parseHex4(str, i + 1);
+					i += 4;
+					if (codepoint >= 0xD800 && codepoint <= 0xDBFF && i + 6 < str.size() && str[i + 1] == '\\' && str[i + 2] == 'u') {
+						auto low = parseHex4(str, i + 3);
+						if (low >= 0xDC00 && low <= 0xDFFF) {
+							codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+							i += 6;
+						}
+					}
+					appendUtf8(result, codepoint);
+					break;
+				}
+				default: result += str[i]; break;
+			}
+		}
+		return result;
+	}
+
+private:
+	auto skipWhitespace() -> char {
+		while (this->pos < this->text.size()) {
+			switch (this->text[this->pos]) {
+				case ' ':
+				case '\t':
+				case '\r':
+				case '\n':
+					++this->pos;
+					continue;
+			}
+			return this->text[this->pos];
+		}
+		return '\0';
+	}
+
+	auto expect(char c) -> void {
+		if (this->skipWhitespace() != c) this->fail("unexpected character");
+		++this->pos;
+	}
+
+	auto expectLiteral(std::string_view literal) -> void {
+		if (this->text.substr(this->pos, literal.size()) != literal) this->fail("invalid literal");
+		this->pos += literal.size();
+	}
+
+	auto scanString() -> std::string_view {
+		auto const start = ++this->pos;
+		while (this->pos < this->text.size()) {
+			auto c = this->text[this->pos];
+			if (c == '"') return this->text.substr(start, this->pos++ - start);
+			this->pos += c == '\\' ? 2 : 1;
+		}
+		this->fail("unterminated string");
+	}
+
+	auto scanNumber() -> std::string_view {
+		auto const start = this->pos;
+		while (this->pos < this->text.size()) {
+			auto c = this->text[this->pos];
+			if ((c < '0' || c > '9') && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') break;
+			++this->pos;
+		}
+		return this->text.substr(start, this->pos - start);
+	}
+
+	[[noreturn]] auto fail(const char* message) const -> void {
+		throw nlohmann::json::parse_error::create(101, this->pos + 1, message, nlohmann::json());
+	}
+
+	static auto parseHex4(std::string_view str, size_t offset) -> uint32_t {
+		uint32_t value = 0;
+		if (offset + 4 > str.size()) return 0xFFFD;
+		std::from_chars(str.data() + offset, str.data() + offset + 4, value, 16);
+		return value;
+	}
+
+	static auto appendUtf8(std::string& str, uint32_t codepoint) -> void {
+		if (codepoint < 0x80) str += static_cast<char>(codepoint);
+		else if (codepoint < 0x800) {
+			str += static_cast<char>(0xC0 | (codepoint >> 6));
+			str += static_cast<char>(0x80 | (codepoint & 0x3F));
+		}
+		else if (codepoint < 0x10000) {
+			str += static_cast<char>(0xE0 | (codepoint >> 12));
+			str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+			str += static_cast<char>(0x80 | (codepoint & 0x3F));
+		}
+		else {
+			str += static_cast<char>(0xF0 | (codepoint >> 18));
+			str += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+			str += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+			str += static_cast<char>(0x80 | (codepoint & 0x3F));
+		}
+	}
+
+private:
+	std::string_view text;
+	size_t pos = 0;
+};
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include "LazyRepository.h"
+#include "json.hpp"
+
+// Returns the index of the quote closing the string whose opening quote is at start, or npos if unterminated.
+static auto findStringEnd(std::string_view json, size_t start) -> size_t {
+	for (auto i = start + 1; i < json.size(); ++i) {
+		i = json.find_first_of("\"\\", i);
+		if (i == std::string_view::npos) break;
+		if (json[i] == '"') return i;
+		++i; // skip the escaped character
+	}
+	return std::string_view::npos;
+}
+
+static auto skipWhitespace(std::string_view json, size_t i) -> size_t {
+	i = json.find_first_not_of(" \t\r\n", i);
+	return i == std::string_view::npos ? json.size() : i;
+}
+
+auto LazyRepository::load(std::string_view json) -> bool {
+	this->json = {};
+	this->index.clear();
+	this->cache.clear();
+
+	// Nothing stays indexed from malformed or truncated data
+	auto const fail = [this] {
+		this->index.clear();
+		return false;
+	};
+
+	auto i = skipWhitespace(json, 0);
+	if (i == json.size() || json[i] != '[') return fail();
+
+	// Single pass over the text, only looking at structure and the keys of the top level objects.
+	// Depth 1 is the array, depth 2 the entries.
+	int depth = 0;
+	size_t objectStart = 0;
+	std::optional<RepoId> objectId;
+
+	while (true) {
+		i = json.find_first_of("\"{}[]", i);
+		if (i == std::string_view::npos) break;
+
+		switch (json[i]) {
+			case '"': {
+				auto const end = findStringEnd(json, i);
+				if (end == std::string_view::npos) return fail();
+
+				auto const next = skipWhitespace(json, end + 1);
+				auto const isIdKey = depth == 2 && next < json.size() && json[next] == ':' && json.substr(i + 1, end - i - 1) == "ID_";
+				i = end + 1;
+
+				if (isIdKey) {
+					auto const valueStart = skipWhitespace(json, next + 1);
+					if (valueStart < json.size() && json[valueStart] == '"') {
+						auto const valueEnd = findStringEnd(json, valueStart);
+						if (valueEnd == std::string_view::npos) return fail();
+						objectId = RepoId::parse(json.substr(valueStart + 1, valueEnd - valueStart - 1));
+						i = valueEnd + 1;
+					}
+				}
+				continue;
+			}
+			case '{':
+				if (++depth == 2) {
+					objectStart = i;
+					objectId.reset();
+				}
+				break;
+			case '[':
+				++depth;
+				break;
+			case '}':
+				if (depth == 2 && objectId) {
+					this->index.push_back({
+						.id = *objectId,
+						.offset = static_cast<uint32_t>(objectStart),
+						.size = static_cast<uint32_t>(i + 1 - objectStart),
+					});
+				}
+				[[fallthrough]];
+			case ']':
+				if (--depth < 0) return fail();
+				break;
+		}
+
+		++i;
+	}
+
+	if (depth != 0) return fail();
+
+	// Sort by ID for lookups, keeping the first of any duplicates like the packer does.
+	std::stable_sort(this->index.begin(), this->index.end(), [](auto const& a, auto const& b) { return a.id < b.id; });
+	this->index.erase(std::unique(this->index.begin(), this->index.end(), [](auto const& a, auto const& b) { return a.id == b.id; }), this->index.end());
+
+	this->json = json;
+	return true;
+}
+
+auto LazyRepository::find(RepoId id) -> std::optional<RepoItem> {
+	auto cached = this->cache.find(id);
+
+	if (cached == this->cache.end()) {
+		auto it = std::lower_bound(this->index.begin(), this->index.end(), id, [](const IndexEntry& entry, RepoId id) {
+			return entry.id < id;
+		});
+
+		if (it == this->index.end() || it->id != id)
+			return std::nullopt;
+
+		cached = this->cache.emplace(id, this->decode(*it)).first;
+	}
+
+	auto const& entry = cached->second;
+	if (!entry.valid) return std::nullopt;
+
+	return RepoItem{
+		.title = entry.title,
+		.commonName = entry.commonName,
+		.itemType = entry.itemType,
+		.inventoryCategoryIcon = entry.inventoryCategoryIcon,
+		.category = entry.category,
+		.isHitmanSuit = entry.isHitmanSuit,
+	};
+}
+
+auto LazyRepository::find(std::string_view id) -> std::optional<RepoItem> {
+	auto const repoId = RepoId::parse(id);
+	if (!repoId) return std::nullopt;
+	return this->find(*repoId);
+}
+
+auto LazyRepository::decode(const IndexEntry& entry) const -> DecodedEntry {
+	DecodedEntry decoded;
+
+	// Malformed entries are cached as missing rather than parsed again on every lookup.
+	auto const item = nlohmann::json::parse(this->json.substr(entry.offset, entry.size), nullptr, false);
+	if (!item.is_object()) return decoded;
+
+	try {
+		decoded.title = item.value("Title", "");
+		decoded.commonName = item.value("CommonName", "");
+		decoded.itemType = item.value("ItemType", "");
+		decoded.inventoryCategoryIcon = item.value("InventoryCategoryIcon", "");
+		decoded.category = classifyRepoItem(decoded.itemType, decoded.inventoryCategoryIcon);
+		decoded.isHitmanSuit = item.value("IsHitmanSuit", false);
+		decoded.valid = true;
+	}
+	catch (const nlohmann::json::exception&) {
+		return {};
+	}
+
+	return decoded;
+}
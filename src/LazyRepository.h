@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "RepoId.h"
+#include "Repository.h"
+
+// Repository read directly from the repo.json text. Loading only indexes where each entry's object is, entries are
+// parsed the first time they're looked up and kept decoded from then on.
+// Lookups modify the cache, so callers must not look up from multiple threads at once.
+class LazyRepository
+{
+public:
+	// Data must outlive the repository.
+	auto load(std::string_view json) -> bool;
+
+	auto find(RepoId id) -> std::optional<RepoItem>;
+	auto find(std::string_view id) -> std::optional<RepoItem>;
+	auto size() const { return this->index.size(); }
+	auto decodedCount() const { return this->cache.size(); }
+
+private:
+	struct IndexEntry
+	{
+		RepoId id;
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	// Owns the strings a RepoItem points to. Map nodes don't move, so the views stay valid.
+	struct DecodedEntry
+	{
+		std::string title;
+		std::string commonName;
+		std::string itemType;
+		std::string inventoryCategoryIcon;
+		ItemInfoType category = ItemInfoType::None;
+		bool isHitmanSuit = false;
+		bool valid = false;
+	};
+
+	auto decode(const IndexEntry& entry) const -> DecodedEntry;
+
+private:
+	std::string_view json;
+	std::vector<IndexEntry> index;
+	std::unordered_map<RepoId, DecodedEntry> cache;
+};
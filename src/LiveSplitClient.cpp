@@ -1,7 +1,9 @@
 #include <WinSock2.h>
+#include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <format>
-#include <map>
+#include <iterator>
 #include <shared_mutex>
 #include <WS2tcpip.h>
 #include <Logging.h>
@@ -14,27 +16,19 @@
 using namespace std::chrono_literals;
 using namespace std::string_literals;
 
-std::map<eClientMessage, std::string> clientMessageTypeMap = {
-	{eClientMessage::StartOrSplit, "startorsplit"},
-	{eClientMessage::Split, "split"},
-	{eClientMessage::Unsplit, "unsplit"},
-	{eClientMessage::SkipSplit, "skipsplit"},
-	{eClientMessage::Pause, "pause"},
-	{eClientMessage::Resume, "resume"},
-	{eClientMessage::Reset, "reset"},
-	{eClientMessage::StartTimer, "starttimer"},
-	{eClientMessage::SwitchTo, "switchto"},
-	{eClientMessage::SetGameTime, "setgametime"},
-	{eClientMessage::GetCurrentTimerPhase, "getcurrenttimerphase"},
-};
-
-auto ClientMessage::toString() const -> std::string {
-	auto it = clientMessageTypeMap.find(this->type);
-	if (it == end(clientMessageTypeMap)) return "";
-	return this->args.size() ? std::format("{} {}", it->second, this->args) : it->second;
-}
+// Longest the writer waits for a response before treating the server as hung and reconnecting
+constexpr DWORD responseTimeoutMs = 1000;
+
+// Reconnection attempts back off exponentially between these delays
+constexpr auto minReconnectDelay = 250ms;
+constexpr auto maxReconnectDelay = 15s;
 
-LiveSplitClient::LiveSplitClient(const ConfigData& config) : config(config) {}
+// How often the tracked timer phase is checked against the server when idle, to catch changes made in LiveSplit
+constexpr DWORD timerPhaseReconcileMs = 5000;
+
+LiveSplitClient::LiveSplitClient(const ConfigData& config) : config(config) {
+	this->wakeEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+}
 
 auto LiveSplitClient::reconnect() -> bool {
 	if (!this->keepOpen) return false;
@@ -76,7 +70,18 @@ auto LiveSplitClient::reconnect() -> bool {
 			Logger::Error("Error connecting to socket");
 		}
 
+		if (this->sock != INVALID_SOCKET) {
+			// Bound blocking calls so a hung server can't stall the writer indefinitely
+			setsockopt(this->sock, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&responseTimeoutMs), sizeof(responseTimeoutMs));
+			setsockopt(this->sock, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&responseTimeoutMs), sizeof(responseTimeoutMs));
+
+			// Commands are tiny and latency sensitive, so don't let Nagle hold them back waiting for an ACK
+			BOOL noDelay = TRUE;
+			setsockopt(this->sock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+		}
+
 		this->connected = this->sock != INVALID_SOCKET;
+		if (this->connected) this->writer.onConnected();
 		freeaddrinfo(addressInfo);
 	}
 
@@ -98,32 +103,28 @@ auto LiveSplitClient::start() -> bool {
 	}
 
 	writeThread = std::thread([this] {
-		std::vector<ClientMessage> writeQueue;
+		std::chrono::milliseconds reconnectDelay = minReconnectDelay;
 
 		while (this->keepOpen) {
 			if (!this->reconnect()) {
-				std::this_thread::sleep_for(3s);
+				// stop() signals the event, so waiting here doesn't hold it up
+				WaitForSingleObject(this->wakeEvent, static_cast<DWORD>(reconnectDelay.count()));
+				reconnectDelay = std::min<std::chrono::milliseconds>(reconnectDelay * 2, maxReconnectDelay);
 				continue;
 			}
 
-			// Process the outward message queue
-			if (this->queueMutex.try_lock()) {
-				while (!this->queue.empty()) {
-					auto& msg = this->queue.back();
-					writeQueue.push_back(std::move(msg));
-					this->queue.pop_back();
-				}
-				this->queueMutex.unlock();
-			}
+			reconnectDelay = minReconnectDelay;
 
-			// Send out messages to socket
-			while (!writeQueue.empty()) {
-				auto& msg = writeQueue.back();
-				if (!this->writeMessage(msg)) break;
-				writeQueue.pop_back();
+			// Whatever wasn't sent is kept by the writer for the next connection
+			if (!this->writer.write(this->connection)) {
+				this->connected = false;
+				continue;
 			}
 
-			if (this->connected) std::this_thread::sleep_for(100ms);
+			// Sleep until enqueue signals more messages. The event is auto-reset and stays signalled if that happened
+			// since the queue was drained, so no wakeup is lost. When idle, periodically check the tracked timer phase.
+			if (WaitForSingleObject(this->wakeEvent, this->writer.isReconcileDue() ? 0 : timerPhaseReconcileMs) == WAIT_TIMEOUT)
+				this->writer.queryTimerPhase(this->connection);
 		}
 	});
 	return true;
@@ -131,6 +132,7 @@ auto LiveSplitClient::start() -> bool {
 
 auto LiveSplitClient::stop() -> void {
 	this->keepOpen = false;
+	SetEvent(this->wakeEvent);
 	this->writeThread.join();
 	this->connected = false;
 
@@ -147,6 +149,7 @@ auto LiveSplitClient::stop() -> void {
 
 auto LiveSplitClient::abort() -> void {
 	this->keepOpen = false;
+	SetEvent(this->wakeEvent);
 	this->writeThread.detach();
 	this->connected = false;
 
@@ -163,54 +166,63 @@ auto LiveSplitClient::abort() -> void {
 
 LiveSplitClient::~LiveSplitClient() {
 	if (this->keepOpen) this->abort();
+	CloseHandle(this->wakeEvent);
 }
 
-auto LiveSplitClient::writeMessage(const ClientMessage& msg) -> bool {
-	auto data = msg.toString() + "\n";
-	DWORD written = 0;
-	int bytes_sent = ::send(this->sock, data.c_str(), data.size(), 0);
-	if (bytes_sent == SOCKET_ERROR) {
-		if (WSAGetLastError() != WSAETIMEDOUT)
-			this->connected = false;
-		return false;
-	}
-	return true;
+auto LiveSplitClient::SocketConnection::send(std::string_view data) -> int {
+	auto const sent = ::send(this->client.sock, data.data(), static_cast<int>(data.size()), 0);
+	if (sent != SOCKET_ERROR) return sent;
+
+	Logger::Error("LiveSplit: send failed {}", WSAGetLastError());
+	this->client.connected = false;
+	return -1;
 }
 
-auto LiveSplitClient::send(eClientMessage type, std::initializer_list<std::string> args) -> void {
+auto LiveSplitClient::SocketConnection::recv(char* buffer, size_t size) -> int {
+	auto const received = ::recv(this->client.sock, buffer, static_cast<int>(size), 0);
+	if (received <= 0) this->client.connected = false;
+	return received;
+}
+
+auto LiveSplitClient::send(eClientMessage type, std::string_view args) -> void {
+	if (!this->connected) return;
+	this->enqueue(ClientMessage(type, args));
+}
+
+auto LiveSplitClient::setGameTime(double gameTime) -> void {
 	if (!this->connected) return;
-	ClientMessage message;
-	message.type = type;
-	std::string argStr;
-	for (auto const& arg : args)
-		argStr += (argStr.empty() ? "" : " ") + arg;
-	message.args = std::move(argStr);
-	if (useQueue)
-		this->queue.push_back(std::move(message));
-	else
-		this->writeMessage(message);
+
+	// Sent every second, so formatted on the stack
+	char buffer[ClientMessage::MaxArgsSize];
+	auto const [end, error] = std::to_chars(std::begin(buffer), std::end(buffer), gameTime, std::chars_format::fixed, 6);
+	if (error != std::errc()) return;
+
+	this->enqueue(ClientMessage(eClientMessage::SetGameTime, std::string_view(buffer, end)));
+}
+
+auto LiveSplitClient::enqueue(ClientMessage&& message) -> void {
+	if (this->writer.enqueue(std::move(message))) {
+		SetEvent(this->wakeEvent);
+		return;
+	}
+
+	Logger::Warn("LiveSplit: message queue full, dropping {}", message.toString());
 }
 
 auto LiveSplitClient::pause() -> void {
-	auto state = this->getTimerPhase();
-	if (state == eLiveSplitTimerPhase::Running)
-		this->send(eClientMessage::Pause);
+	if (!this->connected) return;
+
+	// Decided from the tracked phase where possible, otherwise the writer checks before pausing.
+	// Either way the caller never waits on the server.
+	auto const phase = this->getTimerPhase();
+	if (phase && *phase != eLiveSplitTimerPhase::Running) return;
+
+	ClientMessage message(eClientMessage::Pause);
+	message.onlyIfRunning = !phase;
+	this->enqueue(std::move(message));
 }
 
-auto LiveSplitClient::getTimerPhase() -> std::optional<eLiveSplitTimerPhase> {
+auto LiveSplitClient::getTimerPhase() const -> std::optional<eLiveSplitTimerPhase> {
 	if (!this->connected) return std::nullopt;
-	this->send(eClientMessage::GetCurrentTimerPhase);
-	char buffer[64] = {};
-	auto res = ::recv(this->sock, buffer, sizeof(buffer), 0);
-	if (res > 0) {
-		if ("NotRunning\n"s == buffer)
-			return eLiveSplitTimerPhase::NotRunning;
-		if ("Running\n"s == buffer)
-			return eLiveSplitTimerPhase::Running;
-		if ("Ended\n"s == buffer)
-			return eLiveSplitTimerPhase::Ended;
-		if ("Paused\n"s == buffer)
-			return eLiveSplitTimerPhase::Paused;
-	}
-	return std::nullopt;
+	return this->writer.getTimerPhase();
 }
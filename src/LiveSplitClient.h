@@ -1,48 +1,17 @@
 #pragma once
 #include <atomic>
-#include <deque>
+#include <cstdint>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <thread>
-#include <vector>
 #include <Windows.h>
+#include "LiveSplitProtocol.h"
 
 struct ConfigData;
 
-enum class eClientMessage
-{
-	StartOrSplit,
-	Split,
-	Unsplit,
-	SkipSplit,
-	Pause,
-	Resume,
-	Reset,
-	StartTimer,
-	SwitchTo,
-	SetGameTime,
-
-	GetCurrentTimerPhase,
-};
-
-enum class eLiveSplitTimerPhase
-{
-	NotRunning,
-	Running,
-	Ended,
-	Paused,
-};
-
-class ClientMessage
-{
-public:
-	auto toString() const->std::string;
-
-	eClientMessage type;
-	std::string args;
-};
-
 class LiveSplitClient
 {
 public:
@@ -54,24 +23,40 @@ public:
 	auto abort() -> void;
 	auto isStarted() const -> bool { return this->keepOpen; }
 	auto isConnected() const -> bool { return this->connected; }
-	auto send(eClientMessage type, std::initializer_list<std::string> args = {}) -> void;
+	auto send(eClientMessage type, std::string_view args = {}) -> void;
+	auto setGameTime(double gameTime) -> void;
 	auto pause() -> void;
-	auto getTimerPhase() -> std::optional<eLiveSplitTimerPhase>;
+
+	// Locally tracked timer phase, without a round trip. Nullopt until known.
+	auto getTimerPhase() const -> std::optional<eLiveSplitTimerPhase>;
 
 protected:
 	auto reconnect() -> bool;
-	auto writeMessage(const ClientMessage&) -> bool;
+	auto enqueue(ClientMessage&& message) -> void;
+
+private:
+	// The writer's connection, over the socket. Only used by the writer thread.
+	class SocketConnection : public LiveSplitConnection
+	{
+	public:
+		explicit SocketConnection(LiveSplitClient& client) : client(client)
+		{ }
+
+		auto send(std::string_view data) -> int override;
+		auto recv(char* buffer, size_t size) -> int override;
+
+	private:
+		LiveSplitClient& client;
+	};
 
 private:
 	const ConfigData& config;
-	std::thread clientThread;
 	std::thread writeThread;
-	mutable std::shared_mutex queueMutex;
 	mutable std::shared_mutex connectionMutex;
-	std::deque<ClientMessage> queue;
 	std::atomic_bool connected = false;
 	std::atomic_bool keepOpen = false;
-	bool useQueue = false;
 	SOCKET sock = INVALID_SOCKET;
-	OVERLAPPED overlapped = {};
+	HANDLE wakeEvent = nullptr;
+	SocketConnection connection { *this };
+	LiveSplitWriter writer;
 };
@@ -0,0 +1,221 @@
+#include <iterator>
+#include <Logging.h>
+#include "LiveSplitProtocol.h"
+
+constexpr uint64_t unknownTimerPhase = 0xFF;
+
+// Indexed by eClientMessage
+constexpr std::string_view clientMessageCommands[] = {
+	"startorsplit",
+	"split",
+	"unsplit",
+	"skipsplit",
+	"pause",
+	"resume",
+	"reset",
+	"starttimer",
+	"switchto",
+	"setgametime",
+	"getcurrenttimerphase",
+};
+
+static_assert(std::size(clientMessageCommands) == static_cast<size_t>(eClientMessage::GetCurrentTimerPhase) + 1);
+
+auto ClientMessage::toString() const -> std::string {
+	std::string str;
+	this->appendTo(str);
+	str.pop_back();
+	return str;
+}
+
+auto ClientMessage::appendTo(std::string& buffer) const -> void {
+	buffer += clientMessageCommands[static_cast<size_t>(this->type)];
+
+	if (this->argsSize) {
+		buffer += ' ';
+		buffer += this->args();
+	}
+
+	buffer += '\n';
+}
+
+auto getNextTimerPhase(std::optional<eLiveSplitTimerPhase> phase, eClientMessage type) -> std::optional<eLiveSplitTimerPhase> {
+	switch (type) {
+		case eClientMessage::Reset:
+			return eLiveSplitTimerPhase::NotRunning;
+		case eClientMessage::StartTimer:
+			if (phase == eLiveSplitTimerPhase::NotRunning) return eLiveSplitTimerPhase::Running;
+			return phase;
+		case eClientMessage::StartOrSplit:
+			if (phase == eLiveSplitTimerPhase::NotRunning) return eLiveSplitTimerPhase::Running;
+			[[fallthrough]];
+		case eClientMessage::Split:
+			// Ends the run if it was the last split - assume not, the writer reconciles straight after
+			return phase;
+		case eClientMessage::Unsplit:
+			if (phase == eLiveSplitTimerPhase::Ended) return eLiveSplitTimerPhase::Running;
+			return phase;
+		case eClientMessage::Pause:
+			if (phase == eLiveSplitTimerPhase::Running) return eLiveSplitTimerPhase::Paused;
+			return phase;
+		case eClientMessage::Resume:
+			if (phase == eLiveSplitTimerPhase::Paused) return eLiveSplitTimerPhase::Running;
+			return phase;
+		default:
+			return phase;
+	}
+}
+
+auto parseTimerPhase(std::string_view response) -> std::optional<eLiveSplitTimerPhase> {
+	if (response == "NotRunning")
+		return eLiveSplitTimerPhase::NotRunning;
+	if (response == "Running")
+		return eLiveSplitTimerPhase::Running;
+	if (response == "Ended")
+		return eLiveSplitTimerPhase::Ended;
+	if (response == "Paused")
+		return eLiveSplitTimerPhase::Paused;
+	return std::nullopt;
+}
+
+auto LiveSplitWriter::enqueue(ClientMessage&& message) -> bool {
+	auto const type = message.type;
+	if (!this->queue.push(std::move(message))) return false;
+
+	this->predictTimerPhase(type);
+	return true;
+}
+
+auto LiveSplitWriter::getTimerPhase() const -> std::optional<eLiveSplitTimerPhase> {
+	auto const phase = this->timerPhaseState.load(std::memory_order_acquire) & 0xFF;
+	if (phase == unknownTimerPhase) return std::nullopt;
+	return static_cast<eLiveSplitTimerPhase>(phase);
+}
+
+auto LiveSplitWriter::onConnected() -> void {
+	this->receiveBuffer.clear();
+	this->reconcileDue = true;
+}
+
+auto LiveSplitWriter::write(LiveSplitConnection& connection) -> bool {
+	// Batch up queued messages, oldest first, and send them in a single write
+	if (!this->pending) this->pending = this->queue.pop();
+
+	while (this->pending && this->process(*this->pending, connection)) {
+		if (this->pending->type == eClientMessage::Split || this->pending->type == eClientMessage::StartOrSplit)
+			this->reconcileDue = true;
+
+		this->pending = this->queue.pop();
+	}
+
+	// A message which couldn't be processed is left pending, as the connection failed
+	return !this->pending && this->flush(connection);
+}
+
+auto LiveSplitWriter::process(ClientMessage& message, LiveSplitConnection& connection) -> bool {
+	if (message.onlyIfRunning) {
+		auto phase = this->queryTimerPhase(connection);
+		if (!phase) return false;
+		if (*phase != eLiveSplitTimerPhase::Running) return true;
+	}
+
+	// Only the latest game time matters, so one still waiting in the batch is superseded
+	if (message.type == eClientMessage::SetGameTime) {
+		if (this->gameTimeOffset != std::string::npos)
+			this->sendBuffer.resize(this->gameTimeOffset);
+		this->gameTimeOffset = this->sendBuffer.size();
+	}
+	else this->gameTimeOffset = std::string::npos;
+
+	message.appendTo(this->sendBuffer);
+	return true;
+}
+
+auto LiveSplitWriter::flush(LiveSplitConnection& connection) -> bool {
+	this->gameTimeOffset = std::string::npos;
+	size_t sentSize = 0;
+
+	while (sentSize < this->sendBuffer.size()) {
+		auto const sent = connection.send(std::string_view(this->sendBuffer).substr(sentSize));
+
+		// Including a timeout - the connection is in an indeterminate state after one, so start over on a new one.
+		// The rest of a partly sent message would be garbage to the server, so the whole message is kept from its start.
+		if (sent < 0) {
+			auto const lastSent = sentSize ? this->sendBuffer.rfind('\n', sentSize - 1) : std::string::npos;
+			this->sendBuffer.erase(0, lastSent == std::string::npos ? 0 : lastSent + 1);
+			return false;
+		}
+
+		sentSize += sent;
+	}
+
+	// Keeps the capacity, so batching doesn't allocate once the buffer has grown
+	this->sendBuffer.clear();
+	return true;
+}
+
+auto LiveSplitWriter::queryTimerPhase(LiveSplitConnection& connection) -> std::optional<eLiveSplitTimerPhase> {
+	auto const version = this->timerPhaseState.load(std::memory_order_acquire) >> 8;
+	auto const phase = this->readTimerPhase(connection);
+	this->reconcileTimerPhase(version, phase);
+	this->reconcileDue = false;
+	return phase;
+}
+
+auto LiveSplitWriter::readTimerPhase(LiveSplitConnection& connection) -> std::optional<eLiveSplitTimerPhase> {
+	// Anything batched has to reach the server first for the response to account for it
+	auto const batchSize = this->sendBuffer.size();
+	ClientMessage(eClientMessage::GetCurrentTimerPhase).appendTo(this->sendBuffer);
+	auto const querySize = this->sendBuffer.size() - batchSize;
+
+	// Otherwise drop the query, which would get a response nobody reads, and keep the batch for the next connection.
+	// Whatever was sent is gone from the front of the buffer, but the query is always kept whole at the end.
+	if (!this->flush(connection)) {
+		this->sendBuffer.resize(this->sendBuffer.size() - querySize);
+		return std::nullopt;
+	}
+
+	// Responses are newline terminated, but may arrive in pieces
+	auto end = this->receiveBuffer.find('\n');
+	while (end == std::string::npos) {
+		char buffer[64];
+		auto res = connection.recv(buffer, sizeof(buffer));
+		if (res <= 0) {
+			// Timed out or closed - a late response would be mistaken for the next one, so start over
+			Logger::Error("LiveSplit: no response to timer phase query");
+			return std::nullopt;
+		}
+		this->receiveBuffer.append(buffer, res);
+		end = this->receiveBuffer.find('\n');
+	}
+
+	auto response = std::string_view(this->receiveBuffer).substr(0, end);
+	if (response.ends_with('\r')) response.remove_suffix(1);
+	auto const phase = parseTimerPhase(response);
+	this->receiveBuffer.erase(0, end + 1);
+	return phase;
+}
+
+auto LiveSplitWriter::predictTimerPhase(eClientMessage type) -> void {
+	auto state = this->timerPhaseState.load(std::memory_order_relaxed);
+	uint64_t next;
+
+	do {
+		auto const phase = (state & 0xFF) == unknownTimerPhase
+			? std::nullopt
+			: std::optional(static_cast<eLiveSplitTimerPhase>(state & 0xFF));
+		auto const nextPhase = getNextTimerPhase(phase, type);
+		next = (((state >> 8) + 1) << 8) | (nextPhase ? static_cast<uint64_t>(*nextPhase) : unknownTimerPhase);
+	}
+	while (!this->timerPhaseState.compare_exchange_weak(state, next, std::memory_order_acq_rel));
+}
+
+auto LiveSplitWriter::reconcileTimerPhase(uint64_t version, std::optional<eLiveSplitTimerPhase> phase) -> void {
+	// Only if nothing was queued since the query was sent - its response doesn't account for anything newer
+	auto state = this->timerPhaseState.load(std::memory_order_relaxed);
+	auto const next = (version << 8) | (phase ? static_cast<uint64_t>(*phase) : unknownTimerPhase);
+
+	while (state >> 8 == version) {
+		if (this->timerPhaseState.compare_exchange_weak(state, next, std::memory_order_acq_rel)) break;
+	}
+}
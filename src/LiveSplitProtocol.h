@@ -0,0 +1,134 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "BoundedQueue.h"
+
+// LiveSplit Server's line based protocol - what LiveSplitClient sends and how it reads the responses.
+// Kept apart from the client's sockets and threads so it can be tested on its own.
+
+enum class eClientMessage
+{
+	StartOrSplit,
+	Split,
+	Unsplit,
+	SkipSplit,
+	Pause,
+	Resume,
+	Reset,
+	StartTimer,
+	SwitchTo,
+	SetGameTime,
+
+	GetCurrentTimerPhase,
+};
+
+enum class eLiveSplitTimerPhase
+{
+	NotRunning,
+	Running,
+	Ended,
+	Paused,
+};
+
+// Arguments are stored inline so queueing a message never allocates. The protocol's are a game time or timing method,
+// which always fit - anything longer is cut off.
+class ClientMessage
+{
+public:
+	static constexpr size_t MaxArgsSize = 32;
+
+	explicit ClientMessage(eClientMessage type, std::string_view args = {}) : type(type) {
+		this->argsSize = static_cast<uint8_t>(std::min(args.size(), MaxArgsSize));
+		std::copy_n(args.data(), this->argsSize, this->argsBuffer.data());
+	}
+
+	auto args() const -> std::string_view { return {this->argsBuffer.data(), this->argsSize}; }
+	auto toString() const->std::string;
+	auto appendTo(std::string& buffer) const -> void;
+
+	eClientMessage type;
+
+	// Only send if the timer is running, checked by the writer just before sending
+	bool onlyIfRunning = false;
+
+private:
+	uint8_t argsSize = 0;
+	std::array<char, MaxArgsSize> argsBuffer;
+};
+
+// The phase LiveSplit will be in after a command, or nullopt if that can't be known without asking
+auto getNextTimerPhase(std::optional<eLiveSplitTimerPhase> phase, eClientMessage type) -> std::optional<eLiveSplitTimerPhase>;
+
+// Reads a response to getcurrenttimerphase, without its line ending. Nullopt if it isn't one.
+auto parseTimerPhase(std::string_view response) -> std::optional<eLiveSplitTimerPhase>;
+
+// Where the writer sends messages and reads responses. LiveSplitClient implements it over its socket.
+// Any failure, including a timeout, means the connection is broken and the writer stops using it.
+class LiveSplitConnection
+{
+public:
+	virtual ~LiveSplitConnection() = default;
+
+	// Returns how many bytes were sent, which may be fewer than given, or a negative value on failure.
+	virtual auto send(std::string_view data) -> int = 0;
+
+	// Returns how many bytes were received, or 0 or less if closed or on failure.
+	virtual auto recv(char* buffer, size_t size) -> int = 0;
+};
+
+// Queues messages from any thread and writes them to LiveSplit from one writer thread, batched into a single write.
+// Tracks the timer phase locally, predicted from each queued command and reconciled with the server's.
+// What couldn't be sent is kept for the next connection.
+class LiveSplitWriter
+{
+public:
+	// Any thread. Returns false if the queue is full, in which case message isn't moved from.
+	auto enqueue(ClientMessage&& message) -> bool;
+
+	// Any thread. Nullopt until known.
+	auto getTimerPhase() const -> std::optional<eLiveSplitTimerPhase>;
+
+	// Writer thread only, from here on.
+	// For a new connection - a partial response from the last one is discarded.
+	auto onConnected() -> void;
+
+	// Sends everything queued, oldest first. False if the connection failed.
+	auto write(LiveSplitConnection& connection) -> bool;
+
+	// Asks the server for the timer phase and reconciles the tracked phase with it.
+	auto queryTimerPhase(LiveSplitConnection& connection) -> std::optional<eLiveSplitTimerPhase>;
+
+	// Whether the tracked phase should be checked now rather than when next idle, as it may have been wrong since
+	// connecting or the last split, which may have ended the run.
+	auto isReconcileDue() const -> bool { return this->reconcileDue; }
+
+private:
+	auto process(ClientMessage& message, LiveSplitConnection& connection) -> bool;
+	auto flush(LiveSplitConnection& connection) -> bool;
+	auto readTimerPhase(LiveSplitConnection& connection) -> std::optional<eLiveSplitTimerPhase>;
+
+	auto predictTimerPhase(eClientMessage type) -> void;
+	auto reconcileTimerPhase(uint64_t version, std::optional<eLiveSplitTimerPhase> phase) -> void;
+
+private:
+	BoundedQueue<ClientMessage, 64> queue;
+
+	// Timer phase in the low byte and a version above it, bumped by every prediction, so a query response can't
+	// overwrite the prediction for a command queued after it
+	std::atomic<uint64_t> timerPhaseState = 0xFF;
+
+	// Message which couldn't be sent, retried first once reconnected so the order is kept.
+	// Anything already batched stays in sendBuffer and is flushed before it.
+	std::optional<ClientMessage> pending;
+	std::string sendBuffer;
+
+	// Where the last batched message starts if it's an unsent setgametime, which a newer one replaces
+	size_t gameTimeOffset = std::string::npos;
+	std::string receiveBuffer;
+	bool reconcileDue = true;
+};
@@ -2,22 +2,25 @@
 #include <functional>
 #include <string>
 #include <vector>
+#include "DerivedStats.h"
 
 class Stats;
 
 class PlayStyleRating
 {
 public:
-	PlayStyleRating(std::vector<std::string> titles, std::function<int(const Stats&)> func) : titles(titles), calculateScore(func)
+	PlayStyleRating(std::vector<std::string> titles, StatFields dependencies, std::function<int(const Stats&)> func) : titles(titles), dependencies(dependencies), calculateScore(func)
 	{}
-	PlayStyleRating(const char* title, std::function<int(const Stats&)> func) : PlayStyleRating(std::vector { std::string(title) }, func)
+	PlayStyleRating(const char* title, StatFields dependencies, std::function<int(const Stats&)> func) : PlayStyleRating(std::vector { std::string(title) }, dependencies, func)
 	{}
 
 	auto getScore(const Stats& stats) const { return calculateScore(stats); }
+	auto getDependencies() const { return dependencies; }
 	auto& getTitle(size_t n) const { return titles[n]; }
 	auto& getTitles() const { return titles; }
 
 private:
 	std::vector<std::string> titles;
+	StatFields dependencies;
 	std::function<int(const Stats&)> calculateScore;
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <span>
 #include "PlayStyleRating.h"
 #include "Stats.h"
 #include "FixMinMax.h"
@@ -39,78 +40,78 @@ enum class RatingEventType
  * Or, like, we'll just work it out as we go...
  */
 inline const auto playStyleRatings = std::array{
-	PlayStyleRating("Assassin", [](const Stats& stats) {
+	PlayStyleRating("Assassin", StatFields::Kills, [](const Stats& stats) {
 		return static_cast<int>(stats.kills.targets.size() * 500);
 	}),
-	PlayStyleRating("Ghost", [](const Stats& stats) {
+	PlayStyleRating("Ghost", StatFields::Detection | StatFields::Misc | StatFields::Pacifies | StatFields::Kills | StatFields::Bodies, [](const Stats& stats) {
 		if (stats.detection.spotted || stats.detection.onCamera || stats.misc.recordedThenErased) return 0;
 		if (!stats.misc.timesTrespassed || stats.detection.caughtTrespassing) return 0;
 		if (stats.pacifies.total + stats.kills.total == 0) return 0;
 		if (stats.kills.noticed || stats.pacifies.noticed || stats.bodies.found) return 0;
 		return 600 + static_cast<int>(stats.kills.targets.size() * 400);
 	}),
-	PlayStyleRating("Shadow", [](const Stats& stats) {
+	PlayStyleRating("Shadow", StatFields::Witnesses | StatFields::Detection | StatFields::Misc | StatFields::Pacifies | StatFields::Kills, [](const Stats& stats) {
 		if (stats.witnesses.size() || stats.detection.onCamera) return 0;
 		if (!stats.misc.timesTrespassed) return 0;
 		if (stats.pacifies.total + stats.kills.total == 0) return 0;
 		if (stats.kills.noticed || stats.pacifies.noticed) return 0;
 		return 600 + static_cast<int>(stats.kills.targets.size() * 400);
 	}),
-	PlayStyleRating("Phantom", [](const Stats& stats) {
+	PlayStyleRating("Phantom", StatFields::Witnesses | StatFields::Misc | StatFields::Pacifies | StatFields::Kills, [](const Stats& stats) {
 		if (stats.witnesses.size()) return 0;
 		if (!stats.misc.timesTrespassed) return 0;
 		if (stats.pacifies.total + stats.kills.total == 0) return 0;
 		return 600 + static_cast<int>(stats.kills.targets.size() * 400);
 	}),
 
-	PlayStyleRating("Reckless", [](const Stats& stats) {
+	PlayStyleRating("Reckless", StatFields::Disguises | StatFields::Kills | StatFields::Detection, [](const Stats& stats) {
 		return static_cast<int>(stats.disguisesBlown.size()) * 50
 			+ static_cast<int>(stats.kills.nonTargets.size()) * 30
 			+ stats.kills.noticed * 30
 			+ stats.detection.spotted * 20
 			+ stats.detection.onCamera * 20;
 	}),
-	PlayStyleRating("Bad Actor", [](const Stats& stats) {
+	PlayStyleRating("Bad Actor", StatFields::Disguises, [](const Stats& stats) {
 		return static_cast<int>(stats.disguisesBlown.size() * 250);
 	}),
-	PlayStyleRating("Chameleon", [](const Stats& stats) {
+	PlayStyleRating("Chameleon", StatFields::Misc, [](const Stats& stats) {
 		return stats.misc.disguisesTaken * 200;
 	}),
-	PlayStyleRating("Method Actor", [](const Stats& stats) {
+	PlayStyleRating("Method Actor", StatFields::Disguises | StatFields::Misc, [](const Stats& stats) {
 		if (stats.disguisesBlown.size()) return 0;
 		return stats.misc.disguisesTaken * 250;
 	}),
-	PlayStyleRating("Assailant", [](const Stats& stats) {
+	PlayStyleRating("Assailant", StatFields::Misc, [](const Stats& stats) {
 		return stats.misc.closeCombatEngagements * 200;
 	}),
-	PlayStyleRating("Criminal", [](const Stats& stats) {
+	PlayStyleRating("Criminal", StatFields::Tension | StatFields::Detection, [](const Stats& stats) {
 		if (!stats.tension.arrest && !stats.tension.combat && !stats.tension.alertedHigh) return 0;
 		return std::min(stats.detection.spotted, 3) * 250;
 	}),
-	PlayStyleRating("Fugitive", [](const Stats& stats) {
+	PlayStyleRating("Fugitive", StatFields::Tension | StatFields::Detection, [](const Stats& stats) {
 		if (!stats.tension.arrest) return 0;
 		return stats.detection.spotted * 100;
 	}),
-	PlayStyleRating("Notorious", [](const Stats& stats) {
+	PlayStyleRating("Notorious", StatFields::Current | StatFields::Detection, [](const Stats& stats) {
 		if (!stats.current.disguiseBlown) return 0;
 		return stats.detection.spotted * 100;
 	}),
-	PlayStyleRating("Terrorist", [](const Stats& stats) {
+	PlayStyleRating("Terrorist", StatFields::Kills | StatFields::Tension, [](const Stats& stats) {
 		if (stats.kills.nonTargets.size() < 5) return 0;
 		return stats.tension.level * 6 + static_cast<int>(stats.kills.nonTargets.size() * 5);
 	}),
-	PlayStyleRating("Hacker", [](const Stats& stats) {
+	PlayStyleRating("Hacker", StatFields::Misc, [](const Stats& stats) {
 		return stats.misc.recorderErased * 300;
 	}),
-	PlayStyleRating("Locksmith", [](const Stats& stats) {
+	PlayStyleRating("Locksmith", StatFields::Misc, [](const Stats& stats) {
 		return stats.misc.doorsUnlocked * 50;
 	}),
-	PlayStyleRating("Infiltrator", [](const Stats& stats) {
+	PlayStyleRating("Infiltrator", StatFields::Misc, [](const Stats& stats) {
 		return stats.misc.doorsUnlocked * 25
 			+ stats.misc.agilityActions * 25
 			+ stats.misc.timesTrespassed * 25;
 	}),
-	PlayStyleRating("Spy", [](const Stats& stats) {
+	PlayStyleRating("Spy", StatFields::Detection | StatFields::Kills | StatFields::Items | StatFields::Misc, [](const Stats& stats) {
 		if (stats.detection.spotted) return 0;
 		if (stats.kills.nonTargets.size()) return 0;
 		int count = 0;
@@ -124,7 +125,7 @@ inline const auto playStyleRatings = std::array{
 		}
 		return count * 200 + stats.misc.recorderErased * 100;;
 	}),
-	PlayStyleRating("Hoarder", [](const Stats& stats) {
+	PlayStyleRating("Hoarder", StatFields::Items, [](const Stats& stats) {
 		int count = 0;
 		for (auto const& item : stats.itemsObtained) {
 			switch (item.second.type) {
@@ -142,7 +143,7 @@ inline const auto playStyleRatings = std::array{
 		if (count < 5) return 0;
 		return count * 25;
 	}),
-	PlayStyleRating("Thief", [](const Stats& stats) {
+	PlayStyleRating("Thief", StatFields::Items | StatFields::Misc, [](const Stats& stats) {
 		int count = 0;
 		for (auto const& item : stats.itemsObtained) {
 			switch (item.second.type) {
@@ -158,47 +159,47 @@ inline const auto playStyleRatings = std::array{
 		if (!count) return 0;
 		return count * 25 + stats.misc.doorsUnlocked * 20;
 	}),
-	PlayStyleRating("Litterer", [](const Stats& stats) {
+	PlayStyleRating("Litterer", StatFields::Items, [](const Stats& stats) {
 		return static_cast<int>(stats.itemsDisposed.size() - stats.itemsObtained.size()) * 30;
 	}),
-	PlayStyleRating("Cleaner", [](const Stats& stats) {
+	PlayStyleRating("Cleaner", StatFields::Bodies | StatFields::Kills | StatFields::Pacifies | StatFields::Misc | StatFields::Detection, [](const Stats& stats) {
 		return stats.bodies.hidden * 150 - (stats.kills.total + stats.pacifies.total) * 50
 			+ stats.misc.recorderErased * 100
 			+ stats.detection.witnessesKilled * 100;
 	}),
-	PlayStyleRating("Executioner", [](const Stats& stats) {
+	PlayStyleRating("Executioner", StatFields::Kills, [](const Stats& stats) {
 		return stats.kills.noticed * 60;
 	}),
-	PlayStyleRating("Murderer", [](const Stats& stats) {
+	PlayStyleRating("Murderer", StatFields::Kills, [](const Stats& stats) {
 		if (stats.kills.total >= 47) return 0;
 		return static_cast<int>(stats.kills.nonTargets.size() * 50);
 	}),
-	PlayStyleRating("Serial Killer", [](const Stats& stats) {
+	PlayStyleRating("Serial Killer", StatFields::Kills | StatFields::Witnesses, [](const Stats& stats) {
 		if (stats.kills.total < 3 || stats.kills.noticed > 0) return 0;
 		if (stats.witnesses.size()) return 0;
 		return stats.kills.total * 60;
 	}),
-	PlayStyleRating({"Mass Murderer", "Psychopath"}, [](const Stats& stats) {
+	PlayStyleRating({"Mass Murderer", "Psychopath"}, StatFields::Kills, [](const Stats& stats) {
 		if (stats.kills.total < 47) return 0;
 		return static_cast<int>(stats.kills.nonTargets.size() * 50);
 	}),
-	PlayStyleRating({"Bad Cook", "Envenomer", "Poisoner"}, [](const Stats& stats) {
+	PlayStyleRating({"Bad Cook", "Envenomer", "Poisoner"}, StatFields::Misc, [](const Stats& stats) {
 		return stats.misc.targetsMadeSick * 750;
 	}),
-	PlayStyleRating("Sandman", [](const Stats& stats) {
+	PlayStyleRating("Sandman", StatFields::Pacifies, [](const Stats& stats) {
 		return stats.pacifies.unnoticed * 100;
 	}),
-	PlayStyleRating("Vandal", [](const Stats& stats) {
+	PlayStyleRating("Vandal", StatFields::Misc, [](const Stats& stats) {
 		auto pts = stats.misc.camerasDestroyed * 100;
 		pts += stats.misc.setpiecesDestroyed * 200;
 		pts += stats.misc.objectsDestroyed * 150;
 		pts += stats.misc.recorderDestroyed ? 150 : 0;
 		return pts;
 	}),
-	PlayStyleRating({"Climber", "Hitmantler", "Spider-Hitman", "Traceur"}, [](const Stats& stats) {
+	PlayStyleRating({"Climber", "Hitmantler", "Spider-Hitman", "Traceur"}, StatFields::Misc, [](const Stats& stats) {
 		return stats.misc.agilityActions * 50;
 	}),
-	PlayStyleRating("Civilian", [](const Stats& stats) {
+	PlayStyleRating("Civilian", StatFields::SpottedBy | StatFields::Misc | StatFields::Kills | StatFields::Pacifies | StatFields::Tension, [](const Stats& stats) {
 		return (
 			stats.spottedBy.size()
 			+ stats.misc.timesTrespassed
@@ -215,17 +216,21 @@ inline const auto playStyleRatings = std::array{
 			+ stats.tension.searching
 		) == 0 ? 10 : 0;
 	}),
-	PlayStyleRating("Enigma", [](const Stats& stats) {
+	PlayStyleRating("Enigma", StatFields::None, [](const Stats& stats) {
 		return 1;
 	}),
 };
 
-auto getPlayStyleRating(const Stats& stats) {
+// Only rescores the ratings whose dependencies are in the changed fields.
+auto getPlayStyleRating(const Stats& stats, std::span<DerivedStat<int>> scores, StatFields changed) {
 	const PlayStyleRating* topRating = nullptr;
 	int topScore = -1;
 
-	for (auto const& rating : playStyleRatings) {
-		auto score = rating.getScore(stats);
+	for (size_t i = 0; i < playStyleRatings.size(); ++i) {
+		auto const& rating = playStyleRatings[i];
+		scores[i].update(changed, [&] { return rating.getScore(stats); });
+
+		auto score = scores[i].get();
 		if (score > topScore) {
 			topRating = &rating;
 			topScore = score;
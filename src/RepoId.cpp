@@ -0,0 +1,19 @@
+#include "RepoId.h"
+
+auto RepoIdTable::intern(std::string_view str) -> RepoId {
+	if (str.empty()) return {};
+
+	auto const id = RepoId::parse(str);
+	if (id && *id) return *id;
+
+	auto it = this->ids.find(str);
+	if (it != this->ids.end()) return it->second;
+
+	auto const interned = RepoId{InternedTag, this->ids.size()};
+	this->ids.emplace(str, interned);
+	return interned;
+}
+
+auto RepoIdTable::clear() -> void {
+	this->ids.clear();
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "util.h"
+
+// Repository ID stored as the 128-bit value of its GUID, so comparisons are integer compares and case-insensitive.
+struct RepoId
+{
+	uint64_t high = 0;
+	uint64_t low = 0;
+
+	// Parses a GUID in the form xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx.
+	static constexpr auto parse(std::string_view str) -> std::optional<RepoId> {
+		if (str.size() != 36) return std::nullopt;
+
+		RepoId id;
+		auto digits = 0;
+
+		for (size_t i = 0; i < str.size(); ++i) {
+			auto const c = str[i];
+
+			if (i == 8 || i == 13 || i == 18 || i == 23) {
+				if (c != '-') return std::nullopt;
+				continue;
+			}
+
+			uint64_t nibble = 0;
+			if (c >= '0' && c <= '9') nibble = c - '0';
+			else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+			else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+			else return std::nullopt;
+
+			auto& half = digits < 16 ? id.high : id.low;
+			half = (half << 4) | nibble;
+			++digits;
+		}
+
+		return id;
+	}
+
+	// False for the empty ID.
+	explicit constexpr operator bool() const {
+		return this->high || this->low;
+	}
+
+	constexpr auto operator<=>(const RepoId&) const = default;
+};
+
+template<>
+struct std::hash<RepoId>
+{
+	auto operator()(const RepoId& id) const noexcept -> size_t {
+		return static_cast<size_t>(id.high ^ (id.low * 0x9E3779B97F4A7C15ull));
+	}
+};
+
+// Converts repo ID strings from events to RepoIds. Anything that isn't a GUID (or is the nil GUID, which the game sends
+// for some bodies and must stay distinct from an empty ID) is given a unique ID from the table instead.
+class RepoIdTable
+{
+public:
+	auto intern(std::string_view str) -> RepoId;
+
+	// Forgets the interned strings. IDs interned before this must no longer be in use.
+	auto clear() -> void;
+
+private:
+	static constexpr uint64_t InternedTag = ~0ull;
+
+	std::unordered_map<std::string, RepoId, StringHashLowercase, InsensitiveCompare> ids;
+};
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include "RepoPacker.h"
+#include "Repository.h"
+
+auto packRepository(const nlohmann::json& repo) -> std::string {
+	std::vector<RepoPack::Entry> entries;
+	std::string strings;
+	std::unordered_map<std::string, RepoPack::StringRef> internedStrings;
+
+	auto intern = [&](const std::string& str) -> RepoPack::StringRef {
+		if (str.empty()) return {};
+
+		auto [it, inserted] = internedStrings.try_emplace(str);
+		if (inserted) {
+			it->second.offset = static_cast<uint32_t>(strings.size());
+			it->second.size = static_cast<uint32_t>(str.size());
+			strings += str;
+		}
+		return it->second;
+	};
+
+	if (repo.is_array()) {
+		for (auto const& item : repo) {
+			if (!item.is_object()) continue;
+
+			auto idIt = item.find("ID_");
+			if (idIt == item.end() || !idIt->is_string()) continue;
+
+			auto const id = RepoId::parse(idIt->get_ref<const std::string&>());
+			if (!id) continue;
+
+			auto const itemType = item.value("ItemType", "");
+			auto const inventoryCategoryIcon = item.value("InventoryCategoryIcon", "");
+
+			RepoPack::Entry entry;
+			entry.idHigh = id->high;
+			entry.idLow = id->low;
+			entry.title = intern(item.value("Title", ""));
+			entry.commonName = intern(item.value("CommonName", ""));
+			entry.itemType = intern(itemType);
+			entry.inventoryCategoryIcon = intern(inventoryCategoryIcon);
+			entry.category = classifyRepoItem(itemType, inventoryCategoryIcon);
+			if (item.value("IsHitmanSuit", false)) entry.flags |= RepoPack::IsHitmanSuit;
+			entries.push_back(entry);
+		}
+	}
+
+	// Sort by ID for lookups, keeping the first of any duplicates like the JSON loading did.
+	auto const idOf = [](const RepoPack::Entry& entry) { return RepoId{entry.idHigh, entry.idLow}; };
+	std::stable_sort(entries.begin(), entries.end(), [&](auto const& a, auto const& b) { return idOf(a) < idOf(b); });
+	entries.erase(std::unique(entries.begin(), entries.end(), [&](auto const& a, auto const& b) { return idOf(a) == idOf(b); }), entries.end());
+
+	RepoPack::Header header;
+	std::memcpy(header.magic, RepoPack::Magic, sizeof(header.magic));
+	header.version = RepoPack::Version;
+	header.entryCount = static_cast<uint32_t>(entries.size());
+	header.stringTableSize = static_cast<uint32_t>(strings.size());
+
+	std::string data;
+	data.reserve(sizeof(header) + entries.size() * sizeof(RepoPack::Entry) + strings.size());
+	data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+	data.append(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(RepoPack::Entry));
+	data += strings;
+	return data;
+}
@@ -0,0 +1,6 @@
+#pragma once
+#include <string>
+#include "json.hpp"
+
+// Converts the parsed repo.json array into the packed format read by Repository.
+auto packRepository(const nlohmann::json& repo) -> std::string;
@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <cstring>
+#include "Repository.h"
+
+auto Repository::load(std::string_view data) -> bool {
+	this->entries = {};
+	this->strings = {};
+
+	if (data.size() < sizeof(RepoPack::Header)) return false;
+
+	// Embedded resources aren't guaranteed to be aligned for the entries
+	if (reinterpret_cast<uintptr_t>(data.data()) % alignof(RepoPack::Entry) != 0 && data.data() != this->storage.data())
+		return this->load(std::string(data));
+
+	RepoPack::Header header;
+	std::memcpy(&header, data.data(), sizeof(header));
+
+	if (std::memcmp(header.magic, RepoPack::Magic, sizeof(header.magic)) != 0) return false;
+	if (header.version != RepoPack::Version) return false;
+
+	auto const entriesSize = static_cast<size_t>(header.entryCount) * sizeof(RepoPack::Entry);
+	if (data.size() != sizeof(header) + entriesSize + header.stringTableSize) return false;
+
+	this->entries = {reinterpret_cast<const RepoPack::Entry*>(data.data() + sizeof(header)), header.entryCount};
+	this->strings = data.substr(sizeof(header) + entriesSize);
+	return true;
+}
+
+auto Repository::load(std::string&& data) -> bool {
+	this->storage = std::move(data);
+	return this->load(std::string_view(this->storage));
+}
+
+auto Repository::find(RepoId id) const -> std::optional<RepoItem> {
+	auto it = std::lower_bound(this->entries.begin(), this->entries.end(), id, [](const RepoPack::Entry& entry, RepoId id) {
+		return RepoId{entry.idHigh, entry.idLow} < id;
+	});
+
+	if (it == this->entries.end() || RepoId{it->idHigh, it->idLow} != id)
+		return std::nullopt;
+
+	return RepoItem{
+		.title = this->getString(it->title),
+		.commonName = this->getString(it->commonName),
+		.itemType = this->getString(it->itemType),
+		.inventoryCategoryIcon = this->getString(it->inventoryCategoryIcon),
+		.category = it->category,
+		.isHitmanSuit = (it->flags & RepoPack::IsHitmanSuit) != 0,
+	};
+}
+
+auto Repository::find(std::string_view id) const -> std::optional<RepoItem> {
+	auto const repoId = RepoId::parse(id);
+	if (!repoId) return std::nullopt;
+	return this->find(*repoId);
+}
+
+auto Repository::getString(RepoPack::StringRef ref) const -> std::string_view {
+	if (ref.offset > this->strings.size() || ref.size > this->strings.size() - ref.offset) return {};
+	return this->strings.substr(ref.offset, ref.size);
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include "RepoId.h"
+
+enum class ItemInfoType : uint8_t {
+	None,
+	Key,
+	Intel,
+	Detonator,
+	Coin,
+	Firearm,
+	AmmoBox,
+	Explosive,
+	Melee,
+	LethalMelee,
+	Poison,
+	Briefcase,
+	Other,
+};
+
+// Classifies a repository item by its ItemType and InventoryCategoryIcon.
+constexpr auto classifyRepoItem(std::string_view itemType, std::string_view inventoryCategoryIcon) -> ItemInfoType {
+	if (itemType == "eOther_Keycard_A") return ItemInfoType::Key;
+	if (itemType == "eDetonator" && inventoryCategoryIcon == "remote") return ItemInfoType::Detonator;
+	if (itemType == "eCC_Brick") return ItemInfoType::Other;
+	if (itemType == "eDetonator" && inventoryCategoryIcon == "distraction") return ItemInfoType::Coin;
+	if (itemType == "eItemAmmo") return ItemInfoType::AmmoBox;
+	if (inventoryCategoryIcon == "QuestItem" || inventoryCategoryIcon == "questitem") return ItemInfoType::Intel;
+	if (inventoryCategoryIcon == "poison") return ItemInfoType::Poison;
+	if (inventoryCategoryIcon == "melee") return itemType == "eCC_Knife" ? ItemInfoType::LethalMelee : ItemInfoType::Melee;
+	if (inventoryCategoryIcon == "explosives") return ItemInfoType::Explosive;
+	if (
+		inventoryCategoryIcon == "pistol"
+		|| inventoryCategoryIcon == "smg"
+		|| inventoryCategoryIcon == "shotgun"
+		|| inventoryCategoryIcon == "assaultrifle"
+		|| inventoryCategoryIcon == "sniperrifle"
+	) {
+		return ItemInfoType::Firearm;
+	}
+	return ItemInfoType::Other;
+}
+
+// Binary repository format, generated from repo.json by RepoPack.
+// A header, the entries sorted by ID, then a table of the deduplicated strings they reference.
+namespace RepoPack
+{
+	constexpr char Magic[4] = {'S', 'M', 'R', 'P'};
+	constexpr uint32_t Version = 1;
+
+	enum EntryFlags : uint8_t
+	{
+		IsHitmanSuit = 1 << 0,
+	};
+
+	struct Header
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t stringTableSize;
+	};
+
+	struct StringRef
+	{
+		uint32_t offset = 0;
+		uint32_t size = 0;
+	};
+
+	struct Entry
+	{
+		uint64_t idHigh = 0;
+		uint64_t idLow = 0;
+		StringRef title;
+		StringRef commonName;
+		StringRef itemType;
+		StringRef inventoryCategoryIcon;
+		ItemInfoType category = ItemInfoType::None;
+		uint8_t flags = 0;
+		uint8_t reserved[6] = {};
+	};
+
+	static_assert(sizeof(Header) == 16);
+	static_assert(sizeof(Entry) == 56);
+}
+
+// The fields of a repository entry we use. Strings point into the repository data.
+struct RepoItem
+{
+	std::string_view title;
+	std::string_view commonName;
+	std::string_view itemType;
+	std::string_view inventoryCategoryIcon;
+	ItemInfoType category = ItemInfoType::None;
+	bool isHitmanSuit = false;
+};
+
+// Read-only view of a packed repository. Loading only validates the header, lookups are a binary search by ID.
+class Repository
+{
+public:
+	// Data must outlive the repository.
+	auto load(std::string_view data) -> bool;
+	auto load(std::string&& data) -> bool;
+
+	auto find(RepoId id) const -> std::optional<RepoItem>;
+	auto find(std::string_view id) const -> std::optional<RepoItem>;
+	auto size() const { return this->entries.size(); }
+
+private:
+	auto getString(RepoPack::StringRef ref) const -> std::string_view;
+
+private:
+	std::string storage;
+	std::span<const RepoPack::Entry> entries;
+	std::string_view strings;
+};
@@ -1,5 +1,5 @@
 #pragma once
-
+#include <atomic>
 #include "Stats.h"
 
 enum class FreelancerCampaignStage {
@@ -24,5 +24,6 @@ struct RunData
 {
 	MissionType missionType;
 	FreelancerRunData freelancer;
-	bool shouldAutoStartLiveSplit = false;
+	// Also read by the game thread, for load removal and the IGT feed
+	std::atomic_bool shouldAutoStartLiveSplit = false;
 };
@@ -0,0 +1,38 @@
+#pragma once
+#include <Windows.h>
+
+class ExclusiveLockGuard
+{
+public:
+	explicit ExclusiveLockGuard(SRWLOCK& lock) : lock(lock) {
+		AcquireSRWLockExclusive(&this->lock);
+	}
+
+	~ExclusiveLockGuard() {
+		ReleaseSRWLockExclusive(&this->lock);
+	}
+
+	ExclusiveLockGuard(const ExclusiveLockGuard&) = delete;
+	auto operator=(const ExclusiveLockGuard&) -> ExclusiveLockGuard& = delete;
+
+private:
+	SRWLOCK& lock;
+};
+
+class SharedLockGuard
+{
+public:
+	explicit SharedLockGuard(SRWLOCK& lock) : lock(lock) {
+		AcquireSRWLockShared(&this->lock);
+	}
+
+	~SharedLockGuard() {
+		ReleaseSRWLockShared(&this->lock);
+	}
+
+	SharedLockGuard(const SharedLockGuard&) = delete;
+	auto operator=(const SharedLockGuard&) -> SharedLockGuard& = delete;
+
+private:
+	SRWLOCK& lock;
+};
@@ -0,0 +1,175 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+// Vector which stores up to InlineCapacity elements inside the object itself, only allocating when it grows past that.
+// Spills go to its memory resource, which is also passed on to allocator-aware elements.
+template<typename T, size_t InlineCapacity>
+class SmallVector
+{
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using iterator = T*;
+	using const_iterator = const T*;
+	using reference = T&;
+	using const_reference = const T&;
+	using allocator_type = std::pmr::polymorphic_allocator<T>;
+
+	SmallVector() = default;
+
+	explicit SmallVector(const allocator_type& alloc) : alloc(alloc)
+	{}
+
+	SmallVector(const SmallVector& other, const allocator_type& alloc = {}) : alloc(alloc) {
+		this->copy(other);
+	}
+
+	SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : alloc(other.alloc) {
+		this->take(std::move(other));
+	}
+
+	SmallVector(SmallVector&& other, const allocator_type& alloc) : alloc(alloc) {
+		this->take(std::move(other));
+	}
+
+	~SmallVector() {
+		this->clear();
+		this->deallocate();
+	}
+
+	auto operator=(const SmallVector& other) -> SmallVector& {
+		if (this != &other) {
+			this->clear();
+			this->copy(other);
+		}
+		return *this;
+	}
+
+	// Like the standard containers, assignment keeps this vector's memory resource.
+	auto operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) -> SmallVector& {
+		if (this != &other) {
+			this->clear();
+			this->deallocate();
+			this->take(std::move(other));
+		}
+		return *this;
+	}
+
+	auto begin() -> iterator { return this->ptr; }
+	auto begin() const -> const_iterator { return this->ptr; }
+	auto end() -> iterator { return this->ptr + this->count; }
+	auto end() const -> const_iterator { return this->ptr + this->count; }
+	auto data() -> T* { return this->ptr; }
+	auto data() const -> const T* { return this->ptr; }
+	auto size() const { return this->count; }
+	auto capacity() const { return this->cap; }
+	auto empty() const { return this->count == 0; }
+	auto isInline() const { return this->ptr == this->inlineData(); }
+	auto get_allocator() const { return this->alloc; }
+
+	auto operator[](size_t i) -> T& { return this->ptr[i]; }
+	auto operator[](size_t i) const -> const T& { return this->ptr[i]; }
+	auto back() -> T& { return this->ptr[this->count - 1]; }
+	auto back() const -> const T& { return this->ptr[this->count - 1]; }
+
+	auto reserve(size_t capacity) -> void {
+		if (capacity <= this->cap) return;
+
+		auto const newCap = std::max(capacity, this->cap * 2);
+		auto const newData = this->alloc.allocate(newCap);
+		for (size_t i = 0; i < this->count; ++i)
+			this->alloc.construct(newData + i, std::move(this->ptr[i]));
+		std::destroy(this->begin(), this->end());
+		this->deallocate();
+		this->ptr = newData;
+		this->cap = newCap;
+	}
+
+	template<typename... TArgs>
+	auto emplace(const_iterator pos, TArgs&&... args) -> iterator {
+		auto const index = static_cast<size_t>(pos - this->begin());
+
+		// Construct first, as args may refer to an element which is about to move.
+		auto value = std::make_obj_using_allocator<T>(this->alloc, std::forward<TArgs>(args)...);
+
+		if (this->count == this->cap) this->reserve(this->count + 1);
+
+		if (index == this->count) {
+			this->alloc.construct(this->ptr + this->count, std::move(value));
+		}
+		else {
+			this->alloc.construct(this->ptr + this->count, std::move(this->ptr[this->count - 1]));
+			std::move_backward(this->ptr + index, this->ptr + this->count - 1, this->ptr + this->count);
+			this->ptr[index] = std::move(value);
+		}
+
+		++this->count;
+		return this->ptr + index;
+	}
+
+	template<typename... TArgs>
+	auto emplace_back(TArgs&&... args) -> T& {
+		return *this->emplace(this->end(), std::forward<TArgs>(args)...);
+	}
+
+	auto erase(const_iterator pos) -> iterator {
+		auto const index = static_cast<size_t>(pos - this->begin());
+		std::move(this->ptr + index + 1, this->end(), this->ptr + index);
+		std::destroy_at(this->ptr + this->count - 1);
+		--this->count;
+		return this->ptr + index;
+	}
+
+	// Keeps any heap allocation, so refilling after a clear doesn't allocate again.
+	auto clear() -> void {
+		std::destroy(this->begin(), this->end());
+		this->count = 0;
+	}
+
+private:
+	auto inlineData() -> T* { return std::launder(reinterpret_cast<T*>(this->storage)); }
+	auto inlineData() const -> const T* { return std::launder(reinterpret_cast<const T*>(this->storage)); }
+
+	auto deallocate() -> void {
+		if (!this->isInline()) this->alloc.deallocate(this->ptr, this->cap);
+		this->ptr = this->inlineData();
+		this->cap = InlineCapacity;
+	}
+
+	// Expects this to be empty.
+	auto copy(const SmallVector& other) -> void {
+		this->reserve(other.count);
+		for (auto const& item : other)
+			this->alloc.construct(this->ptr + this->count++, item);
+	}
+
+	// Expects this to be empty and inline. Steals the allocation if both use the same memory resource.
+	auto take(SmallVector&& other) -> void {
+		if (other.isInline() || this->alloc != other.alloc) {
+			this->reserve(other.count);
+			for (auto& item : other)
+				this->alloc.construct(this->ptr + this->count++, std::move(item));
+			other.clear();
+		}
+		else {
+			this->ptr = other.ptr;
+			this->count = other.count;
+			this->cap = other.cap;
+			other.ptr = other.inlineData();
+			other.count = 0;
+			other.cap = InlineCapacity;
+		}
+	}
+
+private:
+	alignas(T) std::byte storage[sizeof(T) * InlineCapacity];
+	allocator_type alloc;
+	T* ptr = this->inlineData();
+	size_t count = 0;
+	size_t cap = InlineCapacity;
+};
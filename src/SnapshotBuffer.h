@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single writer, multiple reader snapshot of a trivially copyable value.
+// The writer cycles through three slots, each guarded by a sequence number, so readers never block the writer and
+// only retry in the unlikely case the writer laps them mid-copy.
+template<typename T>
+class SnapshotBuffer
+{
+	static_assert(std::is_trivially_copyable_v<T>, "SnapshotBuffer requires a trivially copyable type");
+
+	static constexpr size_t SlotCount = 3;
+
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence = 0;
+		T value = {};
+	};
+
+public:
+	// Writer only.
+	auto publish(const T& value) -> void {
+		auto const version = this->latest.load(std::memory_order_relaxed) + 1;
+		auto& slot = this->slots[version % SlotCount];
+
+		slot.sequence.store(version * 2 - 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(&slot.value, &value, sizeof(T));
+		slot.sequence.store(version * 2, std::memory_order_release);
+
+		this->latest.store(version, std::memory_order_release);
+	}
+
+	// Returns the version of the snapshot read, which increases with every publish.
+	auto read(T& value) const -> uint64_t {
+		while (true) {
+			auto const version = this->latest.load(std::memory_order_acquire);
+			auto const& slot = this->slots[version % SlotCount];
+			auto const sequence = slot.sequence.load(std::memory_order_acquire);
+
+			if (sequence != version * 2) continue;
+
+			std::memcpy(&value, &slot.value, sizeof(T));
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+				return version;
+		}
+	}
+
+	auto read() const -> T {
+		T value;
+		this->read(value);
+		return value;
+	}
+
+	auto version() const -> uint64_t {
+		return this->latest.load(std::memory_order_acquire);
+	}
+
+private:
+	std::array<Slot, SlotCount> slots;
+	std::atomic<uint64_t> latest = 0;
+};
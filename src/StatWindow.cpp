@@ -234,7 +234,7 @@ private:
 	TextAlign align = TextAlign::Left;
 };
 
-StatWindow::StatWindow(const DisplayStats& stats) : stats(stats)
+StatWindow::StatWindow(const SnapshotBuffer<StatsSnapshot>& snapshots) : snapshots(snapshots)
 {
 }
 
@@ -398,6 +398,8 @@ auto StatWindow::paint(HWND wnd) -> void
 
 	GetClientRect(wnd, &rect);
 
+	this->stats = this->snapshots.read().display;
+
 	auto hdc = BeginPaint(wnd, &ps);
 	auto oldBkMode = SetBkMode(hdc, TRANSPARENT);
 
@@ -2,6 +2,7 @@
 #include <string>
 #include <thread>
 #include <Windows.h>
+#include "SnapshotBuffer.h"
 #include "Stats.h"
 
 #define STEALTHOMETER_UPDATE_WINDOW (WM_USER + 0x01)
@@ -31,7 +32,7 @@ class StatWindow
 	};
 
 public:
-	StatWindow(const DisplayStats&);
+	StatWindow(const SnapshotBuffer<StatsSnapshot>&);
 	~StatWindow();
 
 	auto create(HINSTANCE instance) -> void;
@@ -51,7 +52,8 @@ protected:
 	static auto registerWindowClass(HINSTANCE instance, HWND parentWindow) -> ATOM;
 
 private:
-	const DisplayStats& stats;
+	const SnapshotBuffer<StatsSnapshot>& snapshots;
+	DisplayStats stats;
 	HWND hWnd = nullptr;
 	HWND column1 = nullptr;
 	HWND column2 = nullptr;
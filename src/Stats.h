@@ -1,11 +1,15 @@
 #pragma once
-#include <map>
-#include <set>
+#include <memory_resource>
 #include <string>
-#include <unordered_set>
+#include <string_view>
+#include <vector>
 #include <Glacier/Enums.h>
 #include "Enums.h"
+#include "FlatMap.h"
+#include "FlatSet.h"
 #include "PlayStyleRating.h"
+#include "RepoId.h"
+#include "Repository.h"
 #include "util.h"
 
 enum class SilentAssassinStatus
@@ -43,29 +47,14 @@ struct DisplayStats
 	SilentAssassinStatus silentAssassin = SilentAssassinStatus::OK;
 };
 
-enum class ItemInfoType {
-	None,
-	Key,
-	Intel,
-	Detonator,
-	Coin,
-	Firearm,
-	AmmoBox,
-	Explosive,
-	Melee,
-	LethalMelee,
-	Poison,
-	Briefcase,
-	Other,
-};
-
+// Strings point into the repository, which outlives any stats.
 struct ItemInfo
 {
 	ItemInfoType type = ItemInfoType::None;
-	std::string name;
-	std::string commonName;
-	std::string itemType;
-	std::string inventoryCategoryIcon;
+	std::string_view name;
+	std::string_view commonName;
+	std::string_view itemType;
+	std::string_view inventoryCategoryIcon;
 	int count = 1;
 };
 
@@ -108,14 +97,33 @@ struct KillStats
 {
 	struct NoticedKillInfo
 	{
-		std::map<std::string, bool, InsensitiveCompareLexicographic> sightings;
+		using allocator_type = std::pmr::polymorphic_allocator<>;
+
+		FlatMap<RepoId, bool> sightings;
 		bool isSightedByNonTarget = false;
+
+		NoticedKillInfo() = default;
+		NoticedKillInfo(const NoticedKillInfo&) = default;
+		NoticedKillInfo(NoticedKillInfo&&) = default;
+		auto operator=(const NoticedKillInfo&) -> NoticedKillInfo& = default;
+		auto operator=(NoticedKillInfo&&) -> NoticedKillInfo& = default;
+
+		explicit NoticedKillInfo(const allocator_type& alloc) : sightings(alloc)
+		{}
+
+		NoticedKillInfo(const NoticedKillInfo& other, const allocator_type& alloc) :
+			sightings(other.sightings, alloc), isSightedByNonTarget(other.isSightedByNonTarget)
+		{}
+
+		NoticedKillInfo(NoticedKillInfo&& other, const allocator_type& alloc) :
+			sightings(std::move(other.sightings), alloc), isSightedByNonTarget(other.isSightedByNonTarget)
+		{}
 	};
 
-	std::set<std::string, InsensitiveCompareLexicographic> targets;
-	std::set<std::string, InsensitiveCompareLexicographic> nonTargets;
-	std::set<std::string, InsensitiveCompareLexicographic> proxyDeaths;
-	std::unordered_map<std::string, NoticedKillInfo, StringHashLowercase, InsensitiveCompare> noticedKillInfos;
+	FlatSet<RepoId> targets;
+	FlatSet<RepoId> nonTargets;
+	FlatSet<RepoId> proxyDeaths;
+	FlatMap<RepoId, NoticedKillInfo, 4> noticedKillInfos;
 	int total = 0;
 	int noticed = 0;
 	int unnoticed = 0;
@@ -124,6 +132,12 @@ struct KillStats
 	int guard = 0;
 	int civilian = 0;
 	int crowd = 0;
+
+	KillStats() = default;
+
+	explicit KillStats(std::pmr::memory_resource* resource) :
+		targets(resource), nonTargets(resource), proxyDeaths(resource), noticedKillInfos(resource)
+	{}
 };
 
 struct PacificationStats
@@ -149,12 +163,31 @@ struct BodyStats
 {
 	struct MurderedBodyFoundInfo
 	{
-		std::map<std::string, bool, InsensitiveCompareLexicographic> sightings;
+		using allocator_type = std::pmr::polymorphic_allocator<>;
+
+		FlatMap<RepoId, bool> sightings;
 		bool isSightedByNonTarget = false;
+
+		MurderedBodyFoundInfo() = default;
+		MurderedBodyFoundInfo(const MurderedBodyFoundInfo&) = default;
+		MurderedBodyFoundInfo(MurderedBodyFoundInfo&&) = default;
+		auto operator=(const MurderedBodyFoundInfo&) -> MurderedBodyFoundInfo& = default;
+		auto operator=(MurderedBodyFoundInfo&&) -> MurderedBodyFoundInfo& = default;
+
+		explicit MurderedBodyFoundInfo(const allocator_type& alloc) : sightings(alloc)
+		{}
+
+		MurderedBodyFoundInfo(const MurderedBodyFoundInfo& other, const allocator_type& alloc) :
+			sightings(other.sightings, alloc), isSightedByNonTarget(other.isSightedByNonTarget)
+		{}
+
+		MurderedBodyFoundInfo(MurderedBodyFoundInfo&& other, const allocator_type& alloc) :
+			sightings(std::move(other.sightings), alloc), isSightedByNonTarget(other.isSightedByNonTarget)
+		{}
 	};
 
-	std::set<std::string, InsensitiveCompareLexicographic> uniqueBodiesFound;
-	std::unordered_map<std::string, MurderedBodyFoundInfo, StringHashLowercase, InsensitiveCompare> foundMurderedInfos;
+	FlatSet<RepoId> uniqueBodiesFound;
+	FlatMap<RepoId, MurderedBodyFoundInfo, 4> foundMurderedInfos;
 	bool allHidden = false;
 	bool allTargetsHidden = false;
 	int hidden = 0;
@@ -168,6 +201,12 @@ struct BodyStats
 	int deadSeen = 0;
 	int targetsFound = 0;
 	int bagged = 0;
+
+	BodyStats() = default;
+
+	explicit BodyStats(std::pmr::memory_resource* resource) :
+		uniqueBodiesFound(resource), foundMurderedInfos(resource)
+	{}
 };
 
 struct DetectionStats
@@ -236,11 +275,11 @@ struct Stats
 	struct WitnessEvent {
 		double timestamp;
 		Events event;
-		std::string bodyId;
-		std::string witnessId;
+		RepoId bodyId;
+		RepoId witnessId;
 		bool isWitnessTarget;
 
-		WitnessEvent(double timestamp, Events event, std::string witnessId, bool isWitnessTarget, std::string bodyId = "") :
+		WitnessEvent(double timestamp, Events event, RepoId witnessId, bool isWitnessTarget, RepoId bodyId = {}) :
 			timestamp(timestamp), event(event), witnessId(witnessId), bodyId(bodyId), isWitnessTarget(isWitnessTarget)
 		{}
 	};
@@ -248,15 +287,15 @@ struct Stats
 	double trespassStartTime = 0;
 	double currentTrespassTime = 0;
 	double weaponHoldingStartTime = 0;
-	std::vector<WitnessEvent> witnessEvents;
-	std::set<std::string, InsensitiveCompareLexicographic> witnesses;
-	std::set<std::string, InsensitiveCompareLexicographic> spottedBy;
-	std::set<std::string, InsensitiveCompareLexicographic> targetsSpottedBy;
-	std::set<std::string, InsensitiveCompareLexicographic> targetBodyWitnesses;
-	std::set<std::string, InsensitiveCompareLexicographic> targetKillNoticers;
-	std::set<std::string, InsensitiveCompareLexicographic> disguisesBlown;
-	std::map<std::string, ItemInfo, InsensitiveCompareLexicographic> itemsObtained;
-	std::map<std::string, ItemInfo, InsensitiveCompareLexicographic> itemsDisposed;
+	std::pmr::vector<WitnessEvent> witnessEvents;
+	FlatSet<RepoId> witnesses;
+	FlatSet<RepoId> spottedBy;
+	FlatSet<RepoId> targetsSpottedBy;
+	FlatSet<RepoId> targetBodyWitnesses;
+	FlatSet<RepoId> targetKillNoticers;
+	FlatSet<RepoId> disguisesBlown;
+	FlatMap<RepoId, ItemInfo> itemsObtained;
+	FlatMap<RepoId, ItemInfo> itemsDisposed;
 	KillStats kills;
 	KillMethodStats killMethods;
 	PacificationStats pacifies;
@@ -266,4 +305,36 @@ struct Stats
 	TensionStats tension;
 	CurrentStats current;
 	MiscStats misc;
+
+	Stats() = default;
+
+	// Allocates all containers from the given resource, e.g. a per-contract arena.
+	explicit Stats(std::pmr::memory_resource* resource) :
+		witnessEvents(resource), witnesses(resource), spottedBy(resource), targetsSpottedBy(resource), targetBodyWitnesses(resource),
+		targetKillNoticers(resource), disguisesBlown(resource), itemsObtained(resource), itemsDisposed(resource),
+		kills(resource), bodies(resource)
+	{}
+};
+
+// Copy of the stats shown by the UI, published by the event thread so UI threads can read it without locking.
+struct StatsSnapshot
+{
+	struct KillCounts
+	{
+		int total = 0;
+		int targets = 0;
+		int nonTargets = 0;
+		int noticed = 0;
+		int unnoticed = 0;
+		int unnoticedNonTarget = 0;
+		int guard = 0;
+		int civilian = 0;
+	};
+
+	DisplayStats display;
+	KillCounts kills;
+	PacificationStats pacifies;
+	MiscStats misc;
+	bool onCamera = false;
+	int disguisesBlown = 0;
 };
@@ -1,4 +1,7 @@
 #include <Windows.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <functional>
 #include <ranges>
 #include <thread>
@@ -11,6 +14,7 @@
 #include <Glacier/ZAIGameState.h>
 #include <Glacier/ZActor.h>
 #include <Glacier/ZGameLoopManager.h>
+#include <Glacier/ZHitman5.h>
 #include <Glacier/ZKnowledge.h>
 #include <Glacier/ZModule.h>
 #include <Glacier/ZSpatialEntity.h>
@@ -23,6 +27,8 @@
 #include "Stealthometer.h"
 #include "Enums.h"
 #include "Events.h"
+#include "SRWLockGuard.h"
+#include "JsonReader.h"
 #include "Rating.h"
 #include "Stats.h"
 #include "json.hpp"
@@ -51,36 +57,48 @@ auto APIENTRY DllMain(HMODULE module, DWORD reason, LPVOID) -> BOOL {
 	return TRUE;
 }
 
-Stealthometer::Stealthometer() : window(this->displayStats), randomGenerator(std::random_device{}()), config(*this), liveSplitClient(config.Get()) {
+Stealthometer::Stealthometer() : window(this->statsSnapshots), randomGenerator(std::random_device{}()), config(*this), liveSplitClient(config.Get()) {
+	for (auto const& rating : playStyleRatings)
+		this->playStyleScores.emplace_back(rating.getDependencies());
+
 	this->SetupEvents();
 }
 
 Stealthometer::~Stealthometer() {
 	this->UninstallHooks();
+	this->eventQueue.close();
+	if (this->eventThread.joinable())
+		this->eventThread.join();
 }
 
 auto Stealthometer::Init() -> void
 {
 	InitializeSRWLock(&this->eventLock);
+	this->eventThread = std::thread([this] {
+		this->ProcessEvents();
+	});
 
 	auto const fs = cmrc::stealthometer::get_filesystem();
 
+#ifdef STEALTHOMETER_PACK_REPO
+	// Packed at build time, so loading only checks the header
+	if (!fs.is_file("data/repo.bin"))
+		Logger::Error("Stealthometer: repo.bin not found in embedded filesystem.");
+	else {
+		auto file = fs.open("data/repo.bin");
+		if (!this->repository.load(std::string_view(file.begin(), file.size())))
+			Logger::Error("Stealthometer: repo.bin invalid.");
+	}
+#else
 	if (!fs.is_file("data/repo.json"))
 		Logger::Error("Stealthometer: repo.json not found in embedded filesystem.");
 	else {
+		// Only indexed here, entries are parsed as they're first looked up
 		auto file = fs.open("data/repo.json");
-		auto repo = nlohmann::json::parse(file.begin(), file.end());
-
-		if (repo.is_array()) {
-			for (auto const& entry : repo) {
-				if (!entry.is_object()) continue;
-				auto id = entry.find("ID_");
-				if (id == entry.end()) continue;
-				this->repo.emplace(id.value().get<std::string>(), entry);
-			}
-		}
-		else Logger::Error("Stealthometer: repo.json invalid.");
+		if (!this->repository.load(std::string_view(file.begin(), file.size())))
+			Logger::Error("Stealthometer: repo.json invalid.");
 	}
+#endif
 	//this->window.create(hInstance);
 }
 
@@ -133,23 +151,16 @@ auto Stealthometer::OnEngineInitialized() -> void
 	runData.freelancer.sa = static_cast<SilentAssassinStatus>(config.Get().freelancerSA);
 }
 
-auto Stealthometer::IsRepoIdTargetNPC(const std::string& id) const -> bool {
-	if (this->freelanceTargets.contains(id))
-		return true;
+auto Stealthometer::IsRepoIdTargetNPC(RepoId id) const -> bool {
+	return this->targetRepoIds.contains(id);
+}
 
-	for (auto const& actor : this->actorData) {
-		if (!actor.isTarget) continue;
-		if (InsensitiveCompare{}(id, actor.repoId)) return true;
-	}
-	return false;
+auto Stealthometer::GetRepoEntry(std::string_view id) -> std::optional<RepoItem> {
+	return this->repository.find(id);
 }
 
-auto Stealthometer::GetRepoEntry(const std::string& id) -> const nlohmann::json* {
-	if (!id.empty()) {
-		auto it = this->repo.find(id);
-		if (it != this->repo.end()) return &it->second;
-	}
-	return nullptr;
+auto Stealthometer::GetRepoEntry(RepoId id) -> std::optional<RepoItem> {
+	return this->repository.find(id);
 }
 
 auto Stealthometer::OnFrameUpdateAlways(const SGameUpdateEvent& ev) -> void {
@@ -157,53 +168,175 @@ auto Stealthometer::OnFrameUpdateAlways(const SGameUpdateEvent& ev) -> void {
 }
 
 auto Stealthometer::OnFrameUpdatePlayMode(const SGameUpdateEvent& ev) -> void {
-	for (int i = 0; i < *Globals::NextActorId; ++i) {
-		const auto& actor = Globals::ActorManager->m_aActiveActors[i];
-		const auto actorSpatial = actor.m_ref.QueryInterface<ZSpatialEntity>();
-		auto& actorData = this->actorData[i];
-
-		if (!actorData.ref) {
-			actorData.ref = &actor;
-			auto repoEntity = actor.m_ref.QueryInterface<ZRepositoryItemEntity>();
-			actorData.repoId = repoEntity->m_sId.ToString();
-			actorData.isTarget = actor.m_pInterfaceRef->m_bUnk16;
+	// A new contract started on the event thread, so start the scan over
+	auto const contract = this->contractGeneration.load(std::memory_order_acquire);
+	if (contract != this->actorScanContract) {
+		this->actorScanContract = contract;
+		this->ResetActorScan();
+		this->highestGameTimeFed = 0;
+	}
+
+	this->FeedGameTime(ev);
+
+	auto const scanStart = std::chrono::steady_clock::now();
+	auto const actorCount = std::min(static_cast<int>(*Globals::NextActorId), static_cast<int>(ActorTable::Capacity));
+
+	if (this->actorScanFrameCount) {
+		// Smoothed frame time, used to show the scan latency in ms
+		auto const frameTime = std::chrono::duration<double>(scanStart - this->lastActorScan).count();
+		this->averageFrameTime += (frameTime - this->averageFrameTime) * 0.05;
+	}
+	this->lastActorScan = scanStart;
+
+	// Slots past the end are no longer in use
+	if (actorCount < this->resolvedActorCount) {
+		this->actors.truncate(actorCount);
+		this->resolvedActorCount = actorCount;
+	}
+
+	for (; this->resolvedActorCount < actorCount; ++this->resolvedActorCount)
+		this->ResolveActor(this->resolvedActorCount);
+
+	// The player's position tells which actors are near enough to scan every frame when the scan is budgeted
+	auto const scanFrames = static_cast<size_t>(std::max(this->config.Get().actorScanFrames, 1));
+	std::optional<SVector3> playerPosition;
+
+	if (scanFrames > 1) {
+		auto const player = SDK()->GetLocalPlayer();
+		auto const playerSpatial = player.m_pInterfaceRef ? player.m_ref.QueryInterface<ZSpatialEntity>() : nullptr;
+		if (playerSpatial) {
+			auto const playerTransform = playerSpatial->GetWorldMatrix();
+			playerPosition = SVector3{playerTransform.Trans.x, playerTransform.Trans.y, playerTransform.Trans.z};
 		}
+	}
 
-		if (!actorSpatial)
-			continue;
+	auto const priorityCount = this->actors.scan(
+		scanFrames,
+		playerPosition ? &*playerPosition : nullptr,
+		Globals::BehaviorService->m_aKnowledgeData,
+		[this](size_t liveIndex, ZActor* actor) { return this->RefreshActor(liveIndex, actor); },
+		[this](size_t liveIndex, ECompiledBehaviorType behaviourType) { this->OnActorBehaviourChanged(liveIndex, behaviourType); }
+	);
+
+	this->actorScanTime += std::chrono::steady_clock::now() - scanStart;
+	++this->actorScanFrameCount;
+
+	// Stats belong to the event thread, so hand it what changed
+	if (this->actorScanChanges) {
+		EventRecord record;
+		record.type = EventRecordType::ActorScan;
+		record.contract = contract;
+		record.gameTime = this->frameGameTime.load(std::memory_order_relaxed);
+
+		auto const& changes = this->actorScanChanges;
+		if (this->eventQueue.push(record, std::string_view(reinterpret_cast<const char*>(&changes), sizeof(changes))))
+			this->actorScanChanges = {};
+	}
 
-		if (i > this->npcCount)
-			this->npcCount = i;
+	ActorScanStats scanStats;
+	scanStats.liveCount = this->actors.size();
+	scanStats.priorityCount = priorityCount;
+	scanStats.frames = this->actorScanFrameCount;
+	scanStats.averageScanTime = std::chrono::duration<double, std::micro>(this->actorScanTime).count() / this->actorScanFrameCount;
+	scanStats.averageFrameTime = this->averageFrameTime;
+	this->actorScanStats.publish(scanStats);
+}
 
-		if (actor.m_pInterfaceRef->m_nCurrentBehaviorIndex >= 0) {
-			// (&behaviour + 0xD8) = m_pPreviousBehavior ?
+auto Stealthometer::ResetActorScan() -> void {
+	this->actors.clear();
+	this->actorScanChanges = {};
+	this->resolvedActorCount = 0;
+	this->actorScanTime = {};
+	this->actorScanFrameCount = 0;
+	this->npcCount = 0;
+	this->actorScanStats.publish({});
+}
 
-			auto& behaviour = Globals::BehaviorService->m_aKnowledgeData[actor.m_pInterfaceRef->m_nCurrentBehaviorIndex];
-			if (!behaviour.m_pCurrentBehavior) continue;
-			auto behaviourType = static_cast<ECompiledBehaviorType>(behaviour.m_pCurrentBehavior->m_Type);
-			auto lastBehaviourType = actorData.lastFrameBehaviour;
-			actorData.lastFrameBehaviour = behaviourType;
+auto Stealthometer::ResolveActor(int index) -> void {
+	const auto& actor = Globals::ActorManager->m_aActiveActors[index];
+	auto& actors = this->actors;
 
-			if (lastBehaviourType == behaviourType) continue;
+	// Added even without an actor or spatial entity yet, the scan retries those
+	auto const liveIndex = actors.addLive(static_cast<uint16_t>(index), &actor);
+	this->RefreshActor(liveIndex, actor.m_pInterfaceRef);
+}
 
-			auto tension = getBehaviourTension(behaviourType);
+auto Stealthometer::RefreshActor(size_t liveIndex, ZActor* actor) -> bool {
+	auto& actors = this->actors;
+	auto const slot = actors.liveSlot[liveIndex];
 
-			if (behaviourType != ECompiledBehaviorType::BT_Act)
-				Logger::Debug("{}: {}", behaviourToString(behaviourType), tension);
+	if (actor != actors.liveActor[liveIndex]) {
+		actors.reset(liveIndex, actor);
+		actors.repoId[slot] = {};
+		actors.isTarget[slot] = false;
 
-			if (!tension) continue;
+		if (!actor) return false;
 
-			if (behaviourType == ECompiledBehaviorType::BT_CloseCombat)
-				++this->stats.misc.closeCombatEngagements;
+		auto repoEntity = actors.liveRef[liveIndex]->m_ref.QueryInterface<ZRepositoryItemEntity>();
+		auto const repoId = repoEntity ? repoEntity->m_sId.ToString() : ZString();
+		actors.repoId[slot] = RepoId::parse(std::string_view(repoId.c_str(), repoId.size())).value_or(RepoId{});
+		actors.isTarget[slot] = actor->m_bUnk16;
 
-			if (tension > actorData.highestTensionLevel) {
-				if (actorData.highestTensionLevel) tension -= actorData.highestTensionLevel;
-				actorData.highestTensionLevel += tension;
-				this->stats.tension.level += tension;
-				this->UpdateDisplayStats();
-			}
+		// The event thread interns the ID and adds it to the targets
+		if (actors.isTarget[slot]) {
+			EventRecord record;
+			record.type = EventRecordType::ActorTarget;
+			record.contract = this->actorScanContract;
+			if (!this->eventQueue.push(record, std::string_view(repoId.c_str(), repoId.size())))
+				Logger::Error("Stealthometer: event queue full, dropped target: {}", repoId);
 		}
 	}
+
+	if (!actor) return false;
+
+	actors.liveSpatial[liveIndex] = actors.liveRef[liveIndex]->m_ref.QueryInterface<ZSpatialEntity>();
+	if (!actors.liveSpatial[liveIndex]) return false;
+
+	if (slot > this->npcCount)
+		this->npcCount = slot;
+
+	return true;
+}
+
+auto Stealthometer::OnActorBehaviourChanged(size_t liveIndex, ECompiledBehaviorType behaviourType) -> void {
+	auto tension = getBehaviourTension(behaviourType);
+	if (!tension) return;
+
+	if (behaviourType == ECompiledBehaviorType::BT_CloseCombat)
+		++this->actorScanChanges.closeCombatEngagements;
+
+	auto& highestTension = this->actors.highestTension[liveIndex];
+	if (tension > highestTension) {
+		if (highestTension) tension -= highestTension;
+		highestTension += tension;
+		this->actorScanChanges.tension += tension;
+	}
+}
+
+auto Stealthometer::FeedGameTime(const SGameUpdateEvent& ev) -> void {
+	// Events only carry the game time when they happen, so count the frames' game time in between.
+	// Only the game thread writes it.
+	auto const frameGameTime = this->frameGameTime.load(std::memory_order_relaxed) + ev.m_GameTimeDelta.ToSeconds();
+	this->frameGameTime.store(frameGameTime, std::memory_order_relaxed);
+
+	if (!this->config.Get().liveSplitIGTFeed) return;
+
+	// Only during a run, up to the exit, and not while the timer is paused for a load
+	if (!this->runData.shouldAutoStartLiveSplit || this->IsContractEnded() || this->loadRemovalActive) return;
+	if (this->liveSplitClient.getTimerPhase() != eLiveSplitTimerPhase::Running) return;
+
+	// At most one small write a second, the client drops any older game time still waiting to be sent
+	auto const now = std::chrono::steady_clock::now();
+	if (now - this->lastGameTimeFeed < std::chrono::seconds(1)) return;
+	this->lastGameTimeFeed = now;
+
+	// The estimate can run slightly ahead of the next event's timestamp, so it only ever moves forward.
+	// Exact timestamps, like the exit's, are sent as they are.
+	auto const gameTime = frameGameTime + this->eventGameTimeOffset;
+	if (gameTime <= this->highestGameTimeFed) return;
+	this->highestGameTimeFed = gameTime;
+
+	this->liveSplitClient.setGameTime(gameTime);
 }
 
 auto Stealthometer::ProcessLoadRemoval() -> void {
@@ -233,10 +366,8 @@ auto Stealthometer::ProcessLoadRemoval() -> void {
 
 	auto isLoadingScreenActive = renderManager->IsLoadingScreenActive();
 
-	if ((isLoadingScreenActive || loadingScreenActivated) && !loadRemovalActive) {
-		liveSplitClient.pause();
-		loadRemovalActive = true;
-	}
+	if ((isLoadingScreenActive || loadingScreenActivated) && !loadRemovalActive)
+		this->BeginLoadRemoval();
 
 	if (isLoadingScreenActive)
 		isLoadingScreenCheckHasBeenTrue = true;
@@ -245,21 +376,28 @@ auto Stealthometer::ProcessLoadRemoval() -> void {
 		isLoadingScreenCheckHasBeenTrue = false;
 
 		if (loadRemovalActive) {
-			if (this->runData.shouldAutoStartLiveSplit) {
-				liveSplitClient.send(this->startAfterLoad ? eClientMessage::StartTimer : eClientMessage::Resume);
-				this->startAfterLoad = false;
-			}
 			loadRemovalActive = false;
+
+			// A ContractStart handled during the load left the start to us
+			if (this->startPending.exchange(false))
+				liveSplitClient.send(eClientMessage::StartTimer);
+			else if (this->runData.shouldAutoStartLiveSplit)
+				liveSplitClient.send(eClientMessage::Resume);
 		}
 	}
 }
 
+auto Stealthometer::BeginLoadRemoval() -> void {
+	if (loadRemovalActive.exchange(true)) return;
+	liveSplitClient.pause();
+}
+
 auto Stealthometer::OnDrawMenu() -> void {
 	if (ImGui::Button(ICON_MD_PIE_CHART " STEALTHOMETER"))
 		this->statVisibleUI = !this->statVisibleUI;
 }
 
-auto Stealthometer::DrawSettingsUI(bool focused) -> void {
+auto Stealthometer::DrawSettingsUI(const StatsSnapshot& stats, bool focused) -> void {
 	ImGui::PushFont(SDK()->GetImGuiBlackFont());
 
 	ImGui::SetNextWindowSizeConstraints(ImVec2{100, 300}, ImVec2{500, 500});
@@ -343,13 +481,27 @@ auto Stealthometer::DrawSettingsUI(bool focused) -> void {
 
 		if (ImGui::Checkbox("HUD Icon", &cfg.hudIcon)) {
 			if (cfg.hudIcon)
-				hudIcon.create(hInstance, cmrc::stealthometer::get_filesystem(), showHudIcon, displayStats.silentAssassin);
+				hudIcon.create(hInstance, cmrc::stealthometer::get_filesystem(), showHudIcon, stats.display.silentAssassin);
 			else
 				hudIcon.destroy();
 
 			config.Save();
 		}
 
+		if (ImGui::SliderInt("Actor Scan Frames", &cfg.actorScanFrames, 1, 60, "%d", ImGuiSliderFlags_AlwaysClamp))
+			config.Save();
+
+		if (ImGui::CollapsingHeader("Actor Scan")) {
+			// Behaviour changes of actors outside the priority set are seen within this many frames
+			auto const scan = this->actorScanStats.read();
+			auto const sliceSize = (scan.liveCount + cfg.actorScanFrames - 1) / cfg.actorScanFrames;
+			auto const latencyFrames = sliceSize ? (scan.liveCount + sliceSize - 1) / sliceSize : 0;
+
+			ImGui::Text("Live actors: %zu (%zu priority)", scan.liveCount, scan.priorityCount);
+			ImGui::Text("Detection latency: %zu frames (%.0f ms)", latencyFrames, latencyFrames * scan.averageFrameTime * 1000.0);
+			ImGui::Text("Average scan time: %.2f us", scan.averageScanTime);
+		}
+
 		if (ImGui::Button("LiveSplit")) this->liveSplitWindowOpen = true;
 
 		if (ImGui::Button("Kill Stats")) this->killsWindowOpen = true;
@@ -365,7 +517,7 @@ auto Stealthometer::DrawSettingsUI(bool focused) -> void {
 	ImGui::PopFont();
 }
 
-auto Stealthometer::DrawOverlayUI(bool focused) -> void
+auto Stealthometer::DrawOverlayUI(const StatsSnapshot& stats, bool focused) -> void
 {
 	auto& cfg = config.Get();
 	if (!cfg.inGameOverlay) return;
@@ -397,22 +549,22 @@ auto Stealthometer::DrawOverlayUI(bool focused) -> void
 
 		ImGui::PushFont(SDK()->GetImGuiBoldFont());
 
-		if (this->displayStats.silentAssassin == SilentAssassinStatus::OK) {
+		if (stats.display.silentAssassin == SilentAssassinStatus::OK) {
 			ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(0, 255, 0, 255));
 			ImGui::Text("Silent Assassin");
 			ImGui::PopStyleColor();
 		}
-		else if (this->displayStats.silentAssassin == SilentAssassinStatus::RedeemableCamera) {
+		else if (stats.display.silentAssassin == SilentAssassinStatus::RedeemableCamera) {
 			ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(217, 109, 0, 255));
 			ImGui::Text("Cams");
 			ImGui::PopStyleColor();
 		}
-		else if (this->displayStats.silentAssassin == SilentAssassinStatus::RedeemableTarget) {
+		else if (stats.display.silentAssassin == SilentAssassinStatus::RedeemableTarget) {
 			ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(217, 109, 0, 255));
 			ImGui::Text("Target");
 			ImGui::PopStyleColor();
 		}
-		else if (this->displayStats.silentAssassin == SilentAssassinStatus::RedeemableCameraAndTarget) {
+		else if (stats.display.silentAssassin == SilentAssassinStatus::RedeemableCameraAndTarget) {
 			ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(217, 109, 0, 255));
 			ImGui::Text("Cams | Target");
 			ImGui::PopStyleColor();
@@ -420,11 +572,11 @@ auto Stealthometer::DrawOverlayUI(bool focused) -> void
 		else {
 			std::string str;
 
-			if (this->displayStats.spotted > 0)
+			if (stats.display.spotted > 0)
 				str += "Spotted";
-			if (this->displayStats.bodiesFound > 0)
+			if (stats.display.bodiesFound > 0)
 				str += (str.empty() ? ""s : " | "s) + "Body Found"s;
-			if (this->displayStats.civilianKills > 0 || this->displayStats.guardKills > 0)
+			if (stats.display.civilianKills > 0 || stats.display.guardKills > 0)
 				str += (str.empty() ? ""s : " | "s) + "Non-Target Kill"s;
 
 			ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 0, 0, 255));
@@ -481,6 +633,8 @@ auto Stealthometer::DrawLiveSplitUI(bool focused) -> void
 			cfg.liveSplitPort = port;
 			config.Save();
 		}
+		if (ImGui::Checkbox("In-Game Time Feed", &cfg.liveSplitIGTFeed))
+			config.Save();
 
 		if (cfg.liveSplitEnabled && connected) {
 			if (ImGui::Button("Reset")) {
@@ -505,8 +659,7 @@ auto Stealthometer::DrawLiveSplitUI(bool focused) -> void
 	ImGui::PopFont();
 }
 
-auto Stealthometer::DrawExpandedStatsUI(bool focused) -> void {
-	auto const& stats = this->stats;
+auto Stealthometer::DrawExpandedStatsUI(const StatsSnapshot& stats, bool focused) -> void {
 	auto printRow = []<typename T>(const char* label, const char* fmt, T arg) {
 		if (ImGui::TableNextColumn()) ImGui::Text(fmt, arg);
 		if (ImGui::TableNextColumn()) ImGui::TextUnformatted(label);
@@ -603,13 +756,13 @@ auto Stealthometer::DrawExpandedStatsUI(bool focused) -> void {
 
 			if (ImGui::BeginTable("MiscTableL", 2, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_Borders)) {
 				ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthFixed, 15);
-				printRow("Recorded", "%s", stats.misc.recordedThenErased || stats.detection.onCamera ? "Yes" : "No");
+				printRow("Recorded", "%s", stats.misc.recordedThenErased || stats.onCamera ? "Yes" : "No");
 				printRow("Recorder Destroyed", "%s", stats.misc.recorderDestroyed ? "Yes" : "No");
 				printRow("Recorder Erased", "%s", stats.misc.recorderErased ? "Yes" : "No");
 				printRow("Suit Retrieved", "%s", stats.misc.suitRetrieved ? "Yes" : "No");
 				printRow("Agilities", "%d", stats.misc.agilityActions);
 				printRow("Cameras Destroyed", "%d", stats.misc.camerasDestroyed);
-				printRow("Disguises Blown", "%d", stats.disguisesBlown.size());
+				printRow("Disguises Blown", "%d", stats.disguisesBlown);
 				printRow("Disguises Taken", "%d", stats.misc.disguisesTaken);
 				printRow("Doors Unlocked", "%d", stats.misc.doorsUnlocked);
 				printRow("Items Obtained", "%d", stats.misc.itemsPickedUp);
@@ -629,98 +782,75 @@ auto Stealthometer::DrawExpandedStatsUI(bool focused) -> void {
 }
 
 auto Stealthometer::OnDrawUI(bool focused) -> void {
-	this->DrawExpandedStatsUI(focused);
+	auto const stats = this->statsSnapshots.read();
+	this->DrawExpandedStatsUI(stats, focused);
+	this->DrawOverlayUI(stats, focused);
+
+	// These can change run data and settings, so need exclusive access - but only while they're open
+	auto const drawLiveSplit = this->liveSplitWindowOpen && focused;
+	if (!drawLiveSplit && !this->statVisibleUI) return;
+
+	ExclusiveLockGuard lock(this->eventLock);
+
 	this->DrawLiveSplitUI(focused);
-	this->DrawOverlayUI(focused);
 
 	if (!this->statVisibleUI) return;
 
-	this->DrawSettingsUI(focused);
+	this->DrawSettingsUI(stats, focused);
 }
 
 auto Stealthometer::NewContract() -> void {
-	for (auto& actorData : this->actorData) {
-		actorData = ActorData{};
-	}
+	// The game thread resets the actor scan when it sees this, and scan records from before are dropped
+	this->contractGeneration.fetch_add(1, std::memory_order_release);
 
-	this->stats = Stats();
+	// Stats allocates everything from the contract arena, so the reset just rewinds it instead of freeing each node
+	std::destroy_at(&this->stats);
+	this->contractMemory.release();
+	std::construct_at(&this->stats, &this->contractMemory);
 	this->displayStats = DisplayStats();
-	this->npcCount = 0;
 	this->missionEndTime = 0;
 	this->cutsceneEndTime = 0;
-	this->freelanceTargets.clear();
+	this->targetRepoIds.clear();
+	this->repoIds.clear();
 	this->eventHistory.clear();
+	this->changedStats = StatFields::All;
+	this->silentAssassinStatus.reset();
+	this->stealthRating.reset();
+	for (auto& score : this->playStyleScores) score.reset();
+	this->PublishStats();
 	this->window.update();
 }
 
-auto Stealthometer::CreateItemInfo(const std::string& id) -> ItemInfo {
+auto Stealthometer::CreateItemInfo(RepoId id) -> ItemInfo {
 	ItemInfo item;
-	item.type = ItemInfoType::None;
 	auto entry = this->GetRepoEntry(id);
-	if (entry) {
-		auto itemType = entry->value("ItemType", "");
-		auto inventoryCategoryIcon = entry->value("InventoryCategoryIcon", "");
-		auto itemInfoType = ItemInfoType::Other;
+	if (!entry) return item;
 
-		if (itemType == "eOther_Keycard_A") {
-			itemInfoType = ItemInfoType::Key;
+	switch (entry->category) {
+		case ItemInfoType::Key:
 			++stats.misc.keyItemsPickedUp;
-		}
-		else if (itemType == "eDetonator" && inventoryCategoryIcon == "remote") {
-			itemInfoType = ItemInfoType::Detonator;
-		}
-		else if (itemType == "eCC_Brick") {
-			++stats.misc.itemsPickedUp;
-		}
-		else {
+			break;
+		case ItemInfoType::Detonator:
+			return item;
+		case ItemInfoType::Intel:
+			++stats.misc.intelItemsPickedUp;
+			[[fallthrough]];
+		default:
 			++stats.misc.itemsPickedUp;
-
-			if (itemType == "eDetonator" && inventoryCategoryIcon == "distraction")
-				itemInfoType = ItemInfoType::Coin;
-			else if (itemType == "eItemAmmo")
-				itemInfoType = ItemInfoType::AmmoBox;
-			else if (inventoryCategoryIcon == "QuestItem" || inventoryCategoryIcon == "questitem") {
-				itemInfoType = ItemInfoType::Intel;
-				++stats.misc.intelItemsPickedUp;
-			}
-			else if (inventoryCategoryIcon == "poison")
-				itemInfoType = ItemInfoType::Poison;
-			else if (inventoryCategoryIcon == "melee") {
-				if (itemType == "eCC_Knife") itemInfoType = ItemInfoType::LethalMelee;
-				else itemInfoType = ItemInfoType::Melee;
-			}
-			else if (inventoryCategoryIcon == "explosives") {
-				itemInfoType = ItemInfoType::Explosive;
-			}
-			else if (
-				inventoryCategoryIcon == "pistol"
-				|| inventoryCategoryIcon == "smg"
-				|| inventoryCategoryIcon == "shotgun"
-				|| inventoryCategoryIcon == "assaultrifle"
-				|| inventoryCategoryIcon == "sniperrifle"
-			) {
-				itemInfoType = ItemInfoType::Firearm;
-			}
-		}
-
-		switch (itemInfoType) {
-			case ItemInfoType::Detonator: break;
-			default:
-				if (id.empty()) break;
-				item.type = itemInfoType;
-				item.name = entry->value("Title", "");
-				item.commonName = entry->value("CommonName", "");
-				item.itemType = itemType;
-				item.inventoryCategoryIcon = inventoryCategoryIcon;
-				break;
-		}
+			break;
 	}
+
+	item.type = entry->category;
+	item.name = entry->title;
+	item.commonName = entry->commonName;
+	item.itemType = entry->itemType;
+	item.inventoryCategoryIcon = entry->inventoryCategoryIcon;
 	return item;
 }
 
-auto Stealthometer::AddObtainedItem(const std::string& id, ItemInfo item) -> void {
+auto Stealthometer::AddObtainedItem(RepoId id, ItemInfo item) -> void {
 	if (item.type == ItemInfoType::None) return;
-	if (id.empty()) return;
+	if (!id) return;
 	auto it = this->stats.itemsObtained.find(id);
 	if (it != this->stats.itemsObtained.end())
 		++it->second.count;
@@ -728,9 +858,9 @@ auto Stealthometer::AddObtainedItem(const std::string& id, ItemInfo item) -> voi
 		this->stats.itemsObtained.emplace(id, item);
 }
 
-auto Stealthometer::AddDisposedItem(const std::string& id, ItemInfo item) -> void {
+auto Stealthometer::AddDisposedItem(RepoId id, ItemInfo item) -> void {
 	if (item.type == ItemInfoType::None) return;
-	if (id.empty()) return;
+	if (!id) return;
 	auto it = this->stats.itemsDisposed.find(id);
 	if (it != this->stats.itemsDisposed.end())
 		++it->second.count;
@@ -738,8 +868,8 @@ auto Stealthometer::AddDisposedItem(const std::string& id, ItemInfo item) -> voi
 		this->stats.itemsDisposed.emplace(id, item);
 }
 
-auto Stealthometer::RemoveObtainedItem(const std::string& id) -> int {
-	if (id.empty()) return -1;
+auto Stealthometer::RemoveObtainedItem(RepoId id) -> int {
+	if (!id) return -1;
 	auto it = stats.itemsObtained.find(id);
 	if (it != stats.itemsObtained.end()) {
 		if (it->second.count > 1) return --it->second.count;
@@ -755,11 +885,11 @@ auto Stealthometer::GetSilentAssassinStatus() const -> SilentAssassinStatus {
 	if (nonTargetKills > 0) return SilentAssassinStatus::Fail;
 
 	// Spotted
-	auto isKilled = [this](const std::string& id) {
+	auto isKilled = [this](RepoId id) {
 		return this->stats.kills.targets.contains(id)
 			|| this->stats.kills.nonTargets.contains(id);
 	};
-	auto isTarget = [this](const std::string& id) {
+	auto isTarget = [this](RepoId id) {
 		return this->IsRepoIdTargetNPC(id);
 	};
 	auto witnessesNotKilled = this->stats.witnesses | std::views::filter(std::not_fn(isKilled));
@@ -813,8 +943,6 @@ auto Stealthometer::CalculateStealthRating() -> double {
 }
 
 auto Stealthometer::UpdateDisplayStats() -> void {
-	this->window.update();
-
 	auto updated = false;
 
 	// Tension
@@ -900,8 +1028,14 @@ auto Stealthometer::UpdateDisplayStats() -> void {
 		updated = true;
 	}
 
+	// Derived stats are only recomputed when the stats they depend on have changed
+	auto const changed = std::exchange(this->changedStats, StatFields::None);
+
 	// Silent Assassin Status
-	auto sa = this->GetSilentAssassinStatus();
+	[[maybe_unused]] auto const saRecomputed = this->silentAssassinStatus.update(changed, [this] { return this->GetSilentAssassinStatus(); });
+	auto sa = this->silentAssassinStatus.get();
+	// Catches an event handler changing a dependency without getEventStatFields listing it
+	assert(saRecomputed || sa == this->GetSilentAssassinStatus());
 
 	if (this->displayStats.silentAssassin != sa) {
 		this->displayStats.silentAssassin = sa;
@@ -911,25 +1045,47 @@ auto Stealthometer::UpdateDisplayStats() -> void {
 	}
 
 	// Stealth Rating
-	auto rating = this->CalculateStealthRating();
+	[[maybe_unused]] auto const ratingRecomputed = this->stealthRating.update(changed, [this] { return this->CalculateStealthRating(); });
+	auto rating = this->stealthRating.get();
+	assert(ratingRecomputed || rating == this->CalculateStealthRating());
 	if (static_cast<int>(rating * 100) != static_cast<int>(this->displayStats.stealthRating * 100)) {
 		this->displayStats.stealthRating = rating;
 		updated = true;
 	}
 
 	// Play Style
-	auto playStyleRating = getPlayStyleRating(stats);
+	auto playStyleRating = getPlayStyleRating(this->stats, this->playStyleScores, changed);
 	if (playStyleRating) {
 		if (playStyleRating != this->displayStats.playstyle.rating) {
 			std::uniform_int_distribution<size_t> rng(0, playStyleRating->getTitles().size() - 1);
 			this->displayStats.playstyle.rating = playStyleRating;
 			this->displayStats.playstyle.index = rng(this->randomGenerator);
+			updated = true;
 		}
 	}
 
+	this->PublishStats();
 	if (updated) this->window.update();
 }
 
+auto Stealthometer::PublishStats() -> void {
+	StatsSnapshot snapshot;
+	snapshot.display = this->displayStats;
+	snapshot.kills.total = this->stats.kills.total;
+	snapshot.kills.targets = static_cast<int>(this->stats.kills.targets.size());
+	snapshot.kills.nonTargets = static_cast<int>(this->stats.kills.nonTargets.size());
+	snapshot.kills.noticed = this->stats.kills.noticed;
+	snapshot.kills.unnoticed = this->stats.kills.unnoticed;
+	snapshot.kills.unnoticedNonTarget = this->stats.kills.unnoticedNonTarget;
+	snapshot.kills.guard = this->stats.kills.guard;
+	snapshot.kills.civilian = this->stats.kills.civilian;
+	snapshot.pacifies = this->stats.pacifies;
+	snapshot.misc = this->stats.misc;
+	snapshot.onCamera = this->stats.detection.onCamera;
+	snapshot.disguisesBlown = static_cast<int>(this->stats.disguisesBlown.size());
+	this->statsSnapshots.publish(snapshot);
+}
+
 auto Stealthometer::IsContractEnded() const -> bool {
 	return this->missionEndTime > 0;
 }
@@ -1002,10 +1158,16 @@ auto Stealthometer::SetupEvents() -> void {
 	events.listen<Events::ContractStart>([this](const ServerEvent<Events::ContractStart>& ev) {
 		this->runData.missionType = ev.Value.ContractType;
 		this->runData.shouldAutoStartLiveSplit = true;
-		this->startAfterLoad = this->loadRemovalActive;
-		if (!this->loadRemovalActive)
+		// Events are handled after the game sends them, so the load may already be over, in which case start now.
+		// Otherwise the end of the load takes startPending and starts the timer - only one of us gets it.
+		this->startPending = true;
+		if (!this->loadRemovalActive && this->startPending.exchange(false)) {
 			this->liveSplitClient.send(eClientMessage::StartTimer);
-		Logger::Info("ContractStart: {}", ev.json.dump());
+			// A load began while starting, and its pause may have been sent first
+			if (this->loadRemovalActive)
+				this->liveSplitClient.pause();
+		}
+		Logger::Info("ContractStart: {}", ev.Raw);
 		this->NewContract();
 
 		if (ev.Value.LocationId == "LOCATION_SNUG") showHudIcon = 2;
@@ -1024,8 +1186,19 @@ auto Stealthometer::SetupEvents() -> void {
 		showHudIcon = 0;
 		hudIcon.update(showHudIcon, displayStats.silentAssassin);
 
+		auto playStyleRecomputes = 0;
+		for (auto const& score : this->playStyleScores)
+			playStyleRecomputes += score.getRecomputeCount();
+
+		Logger::Debug("Derived stat recomputes - SA: {}, stealth rating: {}, play style scores: {}",
+			this->silentAssassinStatus.getRecomputeCount(), this->stealthRating.getRecomputeCount(), playStyleRecomputes);
+
+		auto const scan = this->actorScanStats.read();
+		if (scan.frames)
+			Logger::Debug("Actor scan - {} live actors, {} frames, average {:.0f}ns", scan.liveCount, scan.frames, scan.averageScanTime * 1000.0);
+
 		if (this->runData.missionType == MissionType::Evergreen) {
-			if (this->runData.freelancer.sa != SilentAssassinStatus::Fail && this->displayStats.silentAssassin != SilentAssassinStatus::OK)
+			if (this->runData.freelancer.sa != SilentAssassinStatus::Fail && this->GetSilentAssassinStatus() != SilentAssassinStatus::OK)
 			{
 				this->runData.freelancer.sa = SilentAssassinStatus::Fail;
 				config.Get().freelancerSA = std::to_underlying(SilentAssassinStatus::Fail);
@@ -1035,7 +1208,7 @@ auto Stealthometer::SetupEvents() -> void {
 	});
 	events.listen<Events::ExitGate>([this](const ServerEvent<Events::ExitGate>& ev) {
 		if (this->runData.missionType == MissionType::Evergreen) {
-			if (this->runData.freelancer.sa != SilentAssassinStatus::Fail && this->displayStats.silentAssassin != SilentAssassinStatus::OK)
+			if (this->runData.freelancer.sa != SilentAssassinStatus::Fail && this->GetSilentAssassinStatus() != SilentAssassinStatus::OK)
 			{
 				this->runData.freelancer.sa = SilentAssassinStatus::Fail;
 				config.Get().freelancerSA = std::to_underlying(SilentAssassinStatus::Fail);
@@ -1044,7 +1217,7 @@ auto Stealthometer::SetupEvents() -> void {
 		}
 		else {
 			this->liveSplitClient.pause();
-			this->liveSplitClient.send(eClientMessage::SetGameTime, {std::to_string(ev.Timestamp)});
+			this->liveSplitClient.setGameTime(ev.Timestamp);
 			this->liveSplitClient.send(eClientMessage::Split);
 			this->runData.shouldAutoStartLiveSplit = false;
 		}
@@ -1059,12 +1232,12 @@ auto Stealthometer::SetupEvents() -> void {
 	});
 	events.listen<Events::AddSyndicateTarget>([this](const ServerEvent<Events::AddSyndicateTarget>& ev) {
 		if (!ev.Value.repoID.empty())
-			this->freelanceTargets.emplace(ev.Value.repoID);
+			this->targetRepoIds.emplace(this->repoIds.intern(ev.Value.repoID));
 	});
 	events.listen<Events::StartingSuit>([this](const ServerEvent<Events::StartingSuit>& ev) {
 		auto entry = this->GetRepoEntry(ev.Value.value);
 		if (entry) {
-			auto const isSuit = entry->value("IsHitmanSuit", false);
+			auto const isSuit = entry->isHitmanSuit;
 			stats.misc.startedInSuit = isSuit;
 			stats.current.inSuit = isSuit;
 		}
@@ -1077,14 +1250,15 @@ auto Stealthometer::SetupEvents() -> void {
 		time -= this->cutsceneEndTime;
 
 		if (time > 3.0) {
-			auto it = stats.itemsObtained.find(ev.Value.RepositoryId);
+			auto const id = this->repoIds.intern(ev.Value.RepositoryId);
+			auto it = stats.itemsObtained.find(id);
 			if (it != stats.itemsObtained.end()) {
 				++it->second.count;
 			}
 			else {
-				auto item = this->CreateItemInfo(ev.Value.RepositoryId);
+				auto item = this->CreateItemInfo(id);
 				if (item.type != ItemInfoType::None)
-					stats.itemsObtained.emplace(ev.Value.RepositoryId, item);
+					stats.itemsObtained.emplace(id, item);
 			}
 		}
 	});
@@ -1092,8 +1266,8 @@ auto Stealthometer::SetupEvents() -> void {
 		if (this->IsContractEnded()) return;
 		++stats.misc.itemsDropped;
 
-		auto& id = ev.Value.RepositoryId;
-		if (!id.empty()) {
+		auto const id = this->repoIds.intern(ev.Value.RepositoryId);
+		if (id) {
 			this->RemoveObtainedItem(id);
 			auto item = this->CreateItemInfo(id);
 			this->AddDisposedItem(id, item);
@@ -1104,13 +1278,14 @@ auto Stealthometer::SetupEvents() -> void {
 		// inventory removal handled in ItemRemovedFromInventory
 		++stats.misc.itemsThrown;
 
-		auto item = this->CreateItemInfo(ev.Value.RepositoryId);
-		this->AddDisposedItem(ev.Value.RepositoryId, item);
+		auto const id = this->repoIds.intern(ev.Value.RepositoryId);
+		auto item = this->CreateItemInfo(id);
+		this->AddDisposedItem(id, item);
 	});
 	events.listen<Events::ItemRemovedFromInventory>([this](const ServerEvent<Events::ItemRemovedFromInventory>& ev) {
 		if (this->IsContractEnded()) return;
 		++stats.misc.itemsRemovedFromInventory;
-		this->RemoveObtainedItem(ev.Value.RepositoryId);
+		this->RemoveObtainedItem(this->repoIds.intern(ev.Value.RepositoryId));
 	});
 	events.listen<Events::FirstNonHeadshot>([this](const ServerEvent<Events::FirstNonHeadshot>& ev) {
 		// TODO: ?
@@ -1189,10 +1364,10 @@ auto Stealthometer::SetupEvents() -> void {
 	// eventually sends other body found events with correct IDs. Need a good solution
 	// to link these events to reliably obtain the necessary information.
 	events.listen<Events::AccidentBodyFound>([this](const ServerEvent<Events::AccidentBodyFound>& ev) {
-		Logger::Debug("{} AccidentBodyFound: {}", ev.Timestamp, ev.json.dump());
+		Logger::Debug("{} AccidentBodyFound: {}", ev.Timestamp, ev.Raw);
 		if (this->IsContractEnded()) return;
 
-		const auto& bodyId = ev.Value.DeadBody.RepositoryId;
+		auto const bodyId = this->repoIds.intern(ev.Value.DeadBody.RepositoryId);
 
 		// Count only if this body is found for the first time, and ensure we don't double count if the body gets dragged and found again.
 		if (stats.bodies.uniqueBodiesFound.emplace(bodyId).second) {
@@ -1204,26 +1379,26 @@ auto Stealthometer::SetupEvents() -> void {
 		}
 	});
 	events.listen<Events::DeadBodySeen>([this](const ServerEvent<Events::DeadBodySeen>& ev) {
-		Logger::Debug("{} DeadBodySeen: {}", ev.Timestamp, ev.json.dump());
+		Logger::Debug("{} DeadBodySeen: {}", ev.Timestamp, ev.Raw);
 		if (this->IsContractEnded()) return;
 		++stats.bodies.deadSeen;
 	});
 	events.listen<Events::MurderedBodySeen>([this, onRealBodyFound](const ServerEvent<Events::MurderedBodySeen>& ev) {
-		Logger::Debug("{} MurderedBodySeen: {}", ev.Timestamp, ev.json.dump());
+		Logger::Debug("{} MurderedBodySeen: {}", ev.Timestamp, ev.Raw);
 		if (this->IsContractEnded()) return;
 
 		auto const& value = ev.Value;
 		auto const& deadBody = value.DeadBody;
-		auto const deadBodyId = deadBody.IsCrowdActor ? "" : deadBody.RepositoryId;
+		auto const deadBodyId = deadBody.IsCrowdActor ? RepoId{} : this->repoIds.intern(deadBody.RepositoryId);
 
-		stats.witnessEvents.emplace_back(ev.Timestamp, Events::MurderedBodySeen, value.Witness, value.IsWitnessTarget, deadBodyId);
+		stats.witnessEvents.emplace_back(ev.Timestamp, Events::MurderedBodySeen, this->repoIds.intern(value.Witness), value.IsWitnessTarget, deadBodyId);
 
-		if (!deadBodyId.empty()) onRealBodyFound(stats.witnessEvents.back());
+		if (deadBodyId) onRealBodyFound(stats.witnessEvents.back());
 	});
 	events.listen<Events::BodyFound>([this, onRealBodyFound](const ServerEvent<Events::BodyFound>& ev) {
-		Logger::Debug("{} BodyFound: {}", ev.Timestamp, ev.json.dump());
+		Logger::Debug("{} BodyFound: {}", ev.Timestamp, ev.Raw);
 
-		auto const& id = ev.Value.DeadBody.RepositoryId;
+		auto const id = this->repoIds.intern(ev.Value.DeadBody.RepositoryId);
 
 		if (ev.Value.DeadBody.IsCrowdActor) {
 			if (this->IsContractEnded()) return;
@@ -1233,7 +1408,7 @@ auto Stealthometer::SetupEvents() -> void {
 			for (auto it = stats.witnessEvents.rbegin(); it != stats.witnessEvents.rend(); ++it) {
 				if (it->timestamp != ev.Timestamp) break; // floating-point equality comparison - should be low enough precision to be fine?
 				if (it->event != Events::MurderedBodySeen) continue;
-				if (!it->bodyId.empty()) continue;
+				if (it->bodyId) continue;
 				it->bodyId = id;
 				onRealBodyFound(*it);
 			}
@@ -1245,7 +1420,7 @@ auto Stealthometer::SetupEvents() -> void {
 
 		auto entry = this->GetRepoEntry(ev.Value.value);
 		if (entry) {
-			auto isHitmanSuit = entry->value("IsHitmanSuit", false);
+			auto isHitmanSuit = entry->isHitmanSuit;
 			if (isHitmanSuit) stats.misc.suitRetrieved = true;
 		}
 	});
@@ -1276,19 +1451,20 @@ auto Stealthometer::SetupEvents() -> void {
 		if (this->IsContractEnded()) return;
 
 		for (const auto& name : ev.Value.value) {
-			auto isTarget = this->IsRepoIdTargetNPC(name);
+			auto const id = this->repoIds.intern(name);
+			auto isTarget = this->IsRepoIdTargetNPC(id);
 
-			if (!stats.spottedBy.contains(name)) {
+			if (!stats.spottedBy.contains(id)) {
 				Logger::Info("Stealthometer: spotted by {} - Target: {}", name, isTarget);
 
 				++stats.detection.spotted;
-				stats.spottedBy.insert(name);
+				stats.spottedBy.insert(id);
 
 				if (isTarget) {
 					// It's possible for the spotted event to fire right AFTER the target died. Handle this dumb edge case.
-					if (stats.kills.targets.contains(name)) continue;
+					if (stats.kills.targets.contains(id)) continue;
 
-					stats.targetsSpottedBy.insert(name);
+					stats.targetsSpottedBy.insert(id);
 				}
 
 				stats.detection.nonTargetsSpottedBy = static_cast<int>(stats.spottedBy.size()) - stats.targetsSpottedBy.size();
@@ -1299,23 +1475,25 @@ auto Stealthometer::SetupEvents() -> void {
 		if (this->IsContractEnded()) return;
 
 		for (const auto& name : ev.Value.value) {
+			auto const id = this->repoIds.intern(name);
+
 			// It's possible for the witnesses event to fire right AFTER the NPC died. Handle this dumb edge case.
-			if (stats.kills.targets.contains(name) || stats.kills.nonTargets.contains(name)) continue;
+			if (stats.kills.targets.contains(id) || stats.kills.nonTargets.contains(id)) continue;
 
-			stats.witnesses.insert(name);
+			stats.witnesses.insert(id);
 		}
 	});
 	events.listen<Events::DisguiseBlown>([this](const ServerEvent<Events::DisguiseBlown>& ev) {
 		if (this->IsContractEnded()) return;
 
 		stats.current.disguiseBlown = true;
-		stats.disguisesBlown.insert(ev.Value.value);
+		stats.disguisesBlown.insert(this->repoIds.intern(ev.Value.value));
 	});
 	events.listen<Events::BrokenDisguiseCleared>([this](const ServerEvent<Events::BrokenDisguiseCleared>& ev) {
 		if (this->IsContractEnded()) return;
 
 		stats.current.disguiseBlown = false;
-		stats.disguisesBlown.erase(ev.Value.value);
+		stats.disguisesBlown.erase(this->repoIds.intern(ev.Value.value));
 	});
 	events.listen<Events::_47_FoundTrespassing>([this](const ServerEvent<Events::_47_FoundTrespassing>& ev) {
 		if (this->IsContractEnded()) return;
@@ -1340,26 +1518,27 @@ auto Stealthometer::SetupEvents() -> void {
 	events.listen<Events::NoticedKill>([this](const ServerEvent<Events::NoticedKill>& ev) {
 		if (this->IsContractEnded()) return;
 
-		Logger::Debug("{} NoticedKill: {}", ev.Timestamp, ev.json.dump());
+		Logger::Debug("{} NoticedKill: {}", ev.Timestamp, ev.Raw);
 
 		// TODO:
 		//ev.Value.RepositoryId
 		//ev.Value.IsTarget
 		auto const& value = ev.Value;
-		auto const noticedKillInfoIt = stats.kills.noticedKillInfos.find(value.RepositoryId);
+		auto const repoId = this->repoIds.intern(value.RepositoryId);
+		auto const noticedKillInfoIt = stats.kills.noticedKillInfos.find(repoId);
 		auto const killAlreadyNoticed = noticedKillInfoIt != stats.kills.noticedKillInfos.end();
 		auto const killAlreadyNoticedByNonTarget = killAlreadyNoticed && noticedKillInfoIt->second.isSightedByNonTarget;
-		auto witnessId = std::string("");
+		auto witnessId = RepoId{};
 
 		for (auto it = stats.witnessEvents.crbegin(); it != stats.witnessEvents.crend(); ++it) {
 			if (it->timestamp != ev.Timestamp) break;
-			if (!it->witnessId.empty()) {
+			if (it->witnessId) {
 				witnessId = it->witnessId;
 				break;
 			}
 		}
 
-		stats.witnessEvents.emplace_back(ev.Timestamp, Events::NoticedKill, witnessId, false, value.RepositoryId);
+		stats.witnessEvents.emplace_back(ev.Timestamp, Events::NoticedKill, witnessId, false, repoId);
 
 		if (killAlreadyNoticed) {
 			if (value.IsTarget) {
@@ -1447,7 +1626,7 @@ auto Stealthometer::SetupEvents() -> void {
 	events.listen<Events::Kill>([this](const ServerEvent<Events::Kill>& ev) {
 		if (this->IsContractEnded()) return;
 
-		const auto& repoId = ev.Value.RepositoryId;
+		const auto repoId = this->repoIds.intern(ev.Value.RepositoryId);
 		const auto isTarget = ev.Value.IsTarget;
 
 		stats.bodies.allHidden = false;
@@ -1631,10 +1810,8 @@ auto Stealthometer::SetupEvents() -> void {
 
 DEFINE_PLUGIN_DETOUR(Stealthometer, void*, OnLoadingScreenActivated, void* th, void* a1) {
 	loadingScreenActivated = true;
-	if (!loadRemovalActive) {
-		liveSplitClient.pause();
-		loadRemovalActive = true;
-	}
+	if (!loadRemovalActive)
+		this->BeginLoadRemoval();
 	return HookResult<void*>(HookAction::Continue());
 }
 
@@ -1642,23 +1819,91 @@ DEFINE_PLUGIN_DETOUR(Stealthometer, void, ZAchievementManagerSimple_OnEventSent,
 	ZString eventData;
 	Functions::ZDynamicObject_ToString->Call(const_cast<ZDynamicObject*>(&ev), &eventData);
 
-	auto eventDataSV = std::string_view(eventData.c_str(), eventData.size());
-	auto fixedEventDataStr = std::string(eventData.size(), '\0');
-	std::remove_copy(eventDataSV.cbegin(), eventDataSV.cend(), fixedEventDataStr.begin(), '\n');
+	// Events are parsed and handled on the event thread, keep the game thread free
+	EventRecord record;
+	record.gameTime = this->frameGameTime.load(std::memory_order_relaxed);
+	if (!this->eventQueue.push(record, std::string_view(eventData.c_str(), eventData.size())))
+		Logger::Error("Stealthometer: event queue full, dropped event: {}", eventData);
 
+	return HookResult<void>(HookAction::Continue());
+}
+
+auto Stealthometer::ProcessEvents() -> void {
+	EventRecord record;
+	std::string data;
+
+	while (this->eventQueue.pop(record, data)) {
+		// Locked per record so the UI is never kept waiting behind a burst
+		{
+			ExclusiveLockGuard lock(this->eventLock);
+			this->HandleRecord(record, data);
+		}
+
+		// Recompute and publish display stats once the burst has been handled, however many records it had
+		if (this->displayStatsDirty && this->eventQueue.empty()) {
+			ExclusiveLockGuard lock(this->eventLock);
+			this->displayStatsDirty = false;
+			this->UpdateDisplayStats();
+		}
+	}
+}
+
+auto Stealthometer::HandleRecord(const EventRecord& record, std::string_view data) -> void {
+	switch (record.type) {
+		case EventRecordType::GameEvent:
+			this->HandleEvent(data, record.gameTime);
+			break;
+		case EventRecordType::ActorScan: {
+			// From a scan of the last contract's actors
+			if (record.contract != this->contractGeneration.load(std::memory_order_relaxed)) break;
+
+			ActorScanChanges changes;
+			if (data.size() != sizeof(changes)) break;
+			std::memcpy(&changes, data.data(), sizeof(changes));
+
+			if (changes.closeCombatEngagements) {
+				this->stats.misc.closeCombatEngagements += changes.closeCombatEngagements;
+				this->changedStats |= StatFields::Misc;
+			}
+			if (changes.tension) {
+				this->stats.tension.level += changes.tension;
+				this->changedStats |= StatFields::Tension;
+			}
+			this->displayStatsDirty = true;
+			break;
+		}
+		case EventRecordType::ActorTarget:
+			if (record.contract != this->contractGeneration.load(std::memory_order_relaxed)) break;
+
+			if (this->targetRepoIds.emplace(this->repoIds.intern(data)).second) {
+				this->changedStats |= StatFields::Targets;
+				this->displayStatsDirty = true;
+			}
+			break;
+		case EventRecordType::SceneCleared:
+			showHudIcon = 0;
+			hudIcon.update(showHudIcon, displayStats.silentAssassin);
+			break;
+	}
+}
+
+auto Stealthometer::HandleEvent(std::string_view eventData, double sentAtFrameGameTime) -> void {
 	try {
-		auto json = nlohmann::json::parse(fixedEventDataStr.c_str(), fixedEventDataStr.c_str() + fixedEventDataStr.size());
-		auto const eventName = json.value("Name", "");
-		auto const timestamp = json.value("Timestamp", 0.0);
+		auto const raw = RawEvent::read(eventData);
+
+		// Relative to when the game sent it rather than now, as the game may have run more frames since
+		if (raw.Timestamp)
+			this->eventGameTimeOffset = raw.Timestamp - sentAtFrameGameTime;
 
-		if (timestamp) lastEventTimestamp = timestamp;
+		auto const& eventName = lookupEventName(raw.Name);
 
-		if (!eventNameBlacklist.contains(eventName)) {
-			if (!events.handle(eventName, json))
+		if (eventName.type != EventNameType::Blacklisted) {
+			if (eventName.type != EventNameType::Event || !events.handle(eventName.event, raw))
 				Logger::Info("Unhandled Event Sent: {}", eventData);
 			else {
-				this->UpdateDisplayStats();
-				this->eventHistory.push_back(eventName);
+				this->changedStats |= getEventStatFields(eventName.event);
+				this->displayStatsDirty = true;
+				this->eventHistory.emplace_back(raw.Name);
 			}
 		}
 	}
@@ -1666,14 +1911,16 @@ DEFINE_PLUGIN_DETOUR(Stealthometer, void, ZAchievementManagerSimple_OnEventSent,
 		Logger::Error("JSON exception: {}", ex.what());
 		Logger::Error("{}", eventData);
 	}
-
-	return HookResult<void>(HookAction::Continue());
 }
 
 DEFINE_PLUGIN_DETOUR(Stealthometer, void, OnClearScene, ZEntitySceneContext* sceneContext, bool forReload)
 {
-	showHudIcon = 0;
-	hudIcon.update(showHudIcon, displayStats.silentAssassin);
+	// The HUD icon state belongs to the event thread
+	EventRecord record;
+	record.type = EventRecordType::SceneCleared;
+	if (!this->eventQueue.push(record, {}))
+		Logger::Error("Stealthometer: event queue full, dropped scene clear");
+
 	return HookResult<void>(HookAction::Continue());
 }
 
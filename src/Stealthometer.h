@@ -1,5 +1,11 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
 #include <random>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -7,24 +13,21 @@
 #include <Glacier/ZEntity.h>
 #include <Glacier/ZInput.h>
 #include "json.hpp"
+#include "ActorTable.h"
 #include "Config.h"
+#include "EventQueue.h"
 #include "Events.h"
 #include "LiveSplitClient.h"
+#include "RepoId.h"
+#include "Repository.h"
+#include "LazyRepository.h"
 #include "RunData.h"
+#include "SnapshotBuffer.h"
 #include "Stats.h"
 #include "StatWindow.h"
 #include "HudIcon.h"
 #include "util.h"
 
-struct ActorData
-{
-	const TEntityRef<ZActor>* ref = nullptr;
-	bool isTarget = false;
-	int highestTensionLevel = 0;
-	ECompiledBehaviorType lastFrameBehaviour = ECompiledBehaviorType::BT_Invalid;
-	std::string repoId;
-};
-
 class Stealthometer : public IPluginInterface
 {
 public:
@@ -40,26 +43,37 @@ public:
 
 	auto NewContract() -> void;
 	auto UpdateDisplayStats() -> void;
+	auto PublishStats() -> void;
 	auto CalculateStealthRating() -> double;
 	auto GetSilentAssassinStatus() const -> SilentAssassinStatus;
 	auto ProcessLoadRemoval() -> void;
+	auto BeginLoadRemoval() -> void;
+	auto FeedGameTime(const SGameUpdateEvent&) -> void;
+	auto ProcessEvents() -> void;
+	auto HandleRecord(const EventRecord& record, std::string_view data) -> void;
+	auto HandleEvent(std::string_view eventData, double sentAtFrameGameTime) -> void;
 
 	auto InstallHooks() -> void;
 	auto UninstallHooks() -> void;
 
 private:
 	auto SetupEvents() -> void;
-	auto DrawSettingsUI(bool focused) -> void;
-	auto DrawExpandedStatsUI(bool focused) -> void;
+	auto DrawSettingsUI(const StatsSnapshot& stats, bool focused) -> void;
+	auto DrawExpandedStatsUI(const StatsSnapshot& stats, bool focused) -> void;
 	auto DrawLiveSplitUI(bool focused) -> void;
-	auto DrawOverlayUI(bool focused) -> void;
+	auto DrawOverlayUI(const StatsSnapshot& stats, bool focused) -> void;
 	auto IsContractEnded() const -> bool;
-	auto IsRepoIdTargetNPC(const std::string& id) const -> bool;
-	auto GetRepoEntry(const std::string& id) -> const nlohmann::json*;
-	auto CreateItemInfo(const std::string& repoId) -> ItemInfo;
-	auto AddObtainedItem(const std::string& id, ItemInfo item) -> void;
-	auto RemoveObtainedItem(const std::string& id) -> int;
-	auto AddDisposedItem(const std::string& id, ItemInfo item) -> void;
+	auto IsRepoIdTargetNPC(RepoId id) const -> bool;
+	auto GetRepoEntry(std::string_view id) -> std::optional<RepoItem>;
+	auto GetRepoEntry(RepoId id) -> std::optional<RepoItem>;
+	auto CreateItemInfo(RepoId id) -> ItemInfo;
+	auto AddObtainedItem(RepoId id, ItemInfo item) -> void;
+	auto RemoveObtainedItem(RepoId id) -> int;
+	auto AddDisposedItem(RepoId id, ItemInfo item) -> void;
+	auto ResetActorScan() -> void;
+	auto ResolveActor(int index) -> void;
+	auto RefreshActor(size_t liveIndex, ZActor* actor) -> bool;
+	auto OnActorBehaviourChanged(size_t liveIndex, ECompiledBehaviorType behaviourType) -> void;
 
 private:
 	//DEFINE_PLUGIN_DETOUR(Stealthometer, void, ZGameStatsManager_SendAISignals, ZGameStatsManager* th);
@@ -68,27 +82,64 @@ private:
 	DECLARE_PLUGIN_DETOUR(Stealthometer, void, OnClearScene, ZEntitySceneContext* sceneContext, bool forReload);
 
 private:
+	// Held by the event thread while it handles a record and publishes stats, and by the UI while it changes settings or
+	// run data. The game thread never takes it - it hands its changes over through eventQueue and atomics.
 	SRWLOCK eventLock = {};
-	Stats stats;
+	EventQueue eventQueue;
+	std::thread eventThread;
+	bool displayStatsDirty = false;
+	std::array<std::byte, 64 * 1024> contractBuffer;
+	std::pmr::monotonic_buffer_resource contractMemory { this->contractBuffer.data(), this->contractBuffer.size() };
+	Stats stats { &this->contractMemory };
 	DisplayStats displayStats;
+	StatFields changedStats = StatFields::All;
+	DerivedStat<SilentAssassinStatus> silentAssassinStatus { silentAssassinStatFields };
+	DerivedStat<double> stealthRating { stealthRatingStatFields };
+	std::vector<DerivedStat<int>> playStyleScores;
+	SnapshotBuffer<StatsSnapshot> statsSnapshots;
 	StatWindow window;
 	HudIcon hudIcon;
 	EventSystem events;
 	Config config;
 	LiveSplitClient liveSplitClient;
-	std::unordered_set<std::string, StringHashLowercase, InsensitiveCompare> freelanceTargets;
-	std::array<ActorData, 1000> actorData;
+	RepoIdTable repoIds;
+	std::unordered_set<RepoId> targetRepoIds;
+
+	// Bumped by NewContract. The game thread starts a new actor scan when it sees the change, and the event thread drops
+	// actor scan records from before it.
+	std::atomic<uint32_t> contractGeneration = 0;
+	SnapshotBuffer<ActorScanStats> actorScanStats;
+
+	// Game thread only
+	uint32_t actorScanContract = 0;
+	ActorTable actors;
+	ActorScanChanges actorScanChanges;
+	int resolvedActorCount = 0;
+	std::chrono::steady_clock::duration actorScanTime = {};
+	std::chrono::steady_clock::time_point lastActorScan = {};
+	double averageFrameTime = 0;
+	int actorScanFrameCount = 0;
+	int npcCount = 0;
 	std::vector<std::string> eventHistory;
 	std::mt19937 randomGenerator;
-	std::unordered_map<std::string, nlohmann::json, StringHashLowercase, InsensitiveCompare> repo;
+#ifdef STEALTHOMETER_PACK_REPO
+	Repository repository;
+#else
+	LazyRepository repository;
+#endif
 
 	RunData runData;
 	//FreelancerRunData freelancer;
 
-	int npcCount = 0;
 	double cutsceneEndTime = 0;
-	double missionEndTime = 0;
-	double lastEventTimestamp = 0;
+	std::atomic<double> missionEndTime = 0;
+	// Game time counted from frame updates by the game thread, which stamps each record with it when pushing
+	std::atomic<double> frameGameTime = 0;
+	// Event timestamp minus the frame game time the event was sent at, from the latest event with a timestamp
+	std::atomic<double> eventGameTimeOffset = 0;
+	// Game thread only
+	double highestGameTimeFed = 0;
+	std::chrono::steady_clock::time_point lastGameTimeFeed = {};
 	bool hooksInstalled = false;
 	bool statVisibleUI = false;
 	bool externalWindowEnabled = true;
@@ -102,10 +153,12 @@ private:
 	bool miscWindowOpen = false;
 	ImVec2 overlaySize = {};
 
-	bool loadRemovalActive = false;
+	// Set from the game thread and the loading screen detour, read by the event thread
+	std::atomic_bool loadRemovalActive = false;
 	bool isLoadingScreenCheckHasBeenTrue = false;
-	bool loadingScreenActivated = false;
-	bool startAfterLoad = false;
+	std::atomic_bool loadingScreenActivated = false;
+	// Set by ContractStart, and taken by whichever of it and the end of a load sends StartTimer
+	std::atomic_bool startPending = false;
 
 	int showHudIcon = 0;
 };
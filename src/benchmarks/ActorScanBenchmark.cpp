@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <Glacier/ZMath.h>
+#include "Benchmark.h"
+#include "ActorTable.h"
+#include "Enums.h"
+
+// The per-frame actor scan on synthetic actor data, in the old array of ActorData records and in ActorTable,
+// with and without a frame budget. ActorTable is run through the same ActorTable::scan as
+// Stealthometer::OnFrameUpdatePlayMode, on stand-ins for the game's types.
+// Actors are only scanned, so this measures the memory traffic of the loop rather than allocations.
+
+// Synthetic stand-ins for the game's types, with the members the scan reads
+class ZActor
+{
+public:
+	std::array<std::byte, 0x1000> state;
+	int32_t m_nCurrentBehaviorIndex = -1;
+	bool m_bUnk16 = false;
+};
+
+struct SMatrix
+{
+	SVector3 Trans;
+};
+
+class ZSpatialEntity
+{
+public:
+	auto GetWorldMatrix() const -> SMatrix { return {this->position}; }
+
+	std::array<std::byte, 0x80> state;
+	SVector3 position;
+};
+
+template<typename T>
+class TEntityRef
+{
+public:
+	void* m_ref = nullptr;
+	T* m_pInterfaceRef = nullptr;
+};
+
+struct SBehavior
+{
+	int32_t m_Type;
+};
+
+struct SKnowledgeData
+{
+	std::array<std::byte, 0x100> state;
+	SBehavior* m_pCurrentBehavior = nullptr;
+};
+
+constexpr size_t ActorCount = 600;
+
+struct World
+{
+	std::vector<std::unique_ptr<ZActor>> actors;
+	std::vector<std::unique_ptr<ZSpatialEntity>> spatials;
+	std::array<TEntityRef<ZActor>, ActorTable::Capacity> activeActors;
+	std::vector<SKnowledgeData> knowledgeData;
+	std::vector<SBehavior> behaviours;
+	SVector3 playerPosition;
+	std::mt19937 random { 42 };
+
+	World() : knowledgeData(ActorCount), behaviours(ActorCount) {
+		std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+
+		// Allocated one at a time and interleaved with other allocations, like the game's
+		std::vector<std::unique_ptr<std::string>> padding;
+		for (size_t i = 0; i < ActorCount; ++i) {
+			auto& actor = this->actors.emplace_back(std::make_unique<ZActor>());
+			actor->m_nCurrentBehaviorIndex = static_cast<int32_t>(i);
+			actor->m_bUnk16 = i % 100 == 0;
+			this->activeActors[i].m_pInterfaceRef = actor.get();
+
+			auto& spatial = this->spatials.emplace_back(std::make_unique<ZSpatialEntity>());
+			spatial->position = {position(this->random), position(this->random), 0.0f};
+			padding.emplace_back(std::make_unique<std::string>(200, 'x'));
+
+			this->behaviours[i].m_Type = static_cast<int32_t>(ECompiledBehaviorType::BT_AmbientStand);
+			this->knowledgeData[i].m_pCurrentBehavior = &this->behaviours[i];
+		}
+	}
+
+	// A few actors change behaviour each frame, some of them alerted
+	auto step() -> void {
+		static constexpr ECompiledBehaviorType behaviourTypes[] = {
+			ECompiledBehaviorType::BT_AmbientStand,
+			ECompiledBehaviorType::BT_AmbientWalk,
+			ECompiledBehaviorType::BT_Patrol,
+			ECompiledBehaviorType::BT_CuriousIdle,
+			ECompiledBehaviorType::BT_SentryIdle,
+			ECompiledBehaviorType::BT_AlertedStand,
+		};
+
+		for (auto n = 0; n < 6; ++n) {
+			auto const i = this->random() % ActorCount;
+			this->behaviours[i].m_Type = static_cast<int32_t>(behaviourTypes[this->random() % std::size(behaviourTypes)]);
+		}
+	}
+};
+
+// The record each actor slot used to have
+struct ActorData
+{
+	const TEntityRef<ZActor>* ref = nullptr;
+	std::string repoId;
+	ECompiledBehaviorType lastFrameBehaviour = ECompiledBehaviorType::BT_Invalid;
+	int highestTensionLevel = 0;
+	bool isTarget = false;
+};
+
+static int tension = 0;
+
+static auto onBehaviourChanged(ECompiledBehaviorType behaviourType, auto& highestTension) -> void {
+	auto level = getBehaviourTension(behaviourType);
+	if (level <= highestTension) return;
+	tension += level - highestTension;
+	highestTension = static_cast<std::remove_reference_t<decltype(highestTension)>>(level);
+}
+
+static auto scanActorData(World& world, std::array<ActorData, ActorTable::Capacity>& actorData) -> void {
+	for (size_t i = 0; i < ActorCount; ++i) {
+		auto const& actor = world.activeActors[i];
+		auto& data = actorData[i];
+
+		if (!data.ref) {
+			data.ref = &actor;
+			data.repoId = "c3d5a8e4-0b6f-4c0d-a1a8-7bb39b22a3f1";
+			data.isTarget = actor.m_pInterfaceRef->m_bUnk16;
+		}
+
+		if (actor.m_pInterfaceRef->m_nCurrentBehaviorIndex < 0) continue;
+
+		auto const& behaviour = world.knowledgeData[actor.m_pInterfaceRef->m_nCurrentBehaviorIndex];
+		if (!behaviour.m_pCurrentBehavior) continue;
+
+		auto const behaviourType = static_cast<ECompiledBehaviorType>(behaviour.m_pCurrentBehavior->m_Type);
+		auto const lastBehaviourType = data.lastFrameBehaviour;
+		data.lastFrameBehaviour = behaviourType;
+		if (lastBehaviourType == behaviourType) continue;
+
+		onBehaviourChanged(behaviourType, data.highestTensionLevel);
+	}
+}
+
+static auto resolveActorTable(World& world, ActorTable& actors) -> void {
+	actors.clear();
+	for (size_t i = 0; i < ActorCount; ++i) {
+		auto const live = actors.addLive(static_cast<uint16_t>(i), &world.activeActors[i]);
+		actors.reset(live, world.activeActors[i].m_pInterfaceRef);
+		actors.liveSpatial[live] = world.spatials[i].get();
+		actors.isTarget[i] = world.activeActors[i].m_pInterfaceRef->m_bUnk16;
+	}
+}
+
+static auto scanActorTable(World& world, ActorTable& actors, size_t scanFrames) -> void {
+	actors.scan(
+		scanFrames,
+		&world.playerPosition,
+		world.knowledgeData,
+		[](size_t, ZActor*) { return false; },
+		[&](size_t liveIndex, ECompiledBehaviorType behaviourType) { onBehaviourChanged(behaviourType, actors.highestTension[liveIndex]); }
+	);
+}
+
+// Times only the scan. Between frames the rest of the game runs and evicts most of the cache, so do the same.
+template<typename TFunc>
+static auto runFrames(const char* name, World& world, TFunc&& scan) -> void {
+	constexpr size_t frames = 5000;
+	static std::vector<std::byte> otherWork(32 * 1024 * 1024);
+	std::chrono::steady_clock::duration elapsed = {};
+
+	for (size_t frame = 0; frame < frames; ++frame) {
+		world.step();
+		for (size_t i = 0; i < otherWork.size(); i += 64) otherWork[i] = static_cast<std::byte>(frame);
+
+		auto const start = std::chrono::steady_clock::now();
+		scan();
+		elapsed += std::chrono::steady_clock::now() - start;
+	}
+
+	std::printf("%-48s %10.1f ns\n", name, std::chrono::duration<double, std::nano>(elapsed).count() / frames);
+}
+
+int main() {
+	World world;
+	auto actorData = std::make_unique<std::array<ActorData, ActorTable::Capacity>>();
+	auto actors = std::make_unique<ActorTable>();
+	resolveActorTable(world, *actors);
+	scanActorData(world, *actorData);
+
+	runFrames("ActorData records, every actor each frame", world, [&] {
+		scanActorData(world, *actorData);
+	});
+
+	runFrames("ActorTable, every actor each frame", world, [&] {
+		scanActorTable(world, *actors, 1);
+	});
+
+	for (auto scanFrames : {4, 15}) {
+		char name[64];
+		std::snprintf(name, sizeof(name), "ActorTable, budget of %d frames", scanFrames);
+		runFrames(name, world, [&] {
+			scanActorTable(world, *actors, scanFrames);
+		});
+	}
+
+	doNotOptimize(tension);
+	return 0;
+}
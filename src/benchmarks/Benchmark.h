@@ -0,0 +1,74 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Minimal harness for the benchmarks. Each benchmark is a single translation unit which includes this once,
+// as it replaces the global allocation functions to count allocations.
+
+inline size_t allocationCount = 0;
+
+auto operator new(size_t size) -> void* {
+	++allocationCount;
+	if (auto ptr = std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc();
+}
+
+auto operator new[](size_t size) -> void* {
+	return ::operator new(size);
+}
+
+auto operator delete(void* ptr) noexcept -> void {
+	std::free(ptr);
+}
+
+auto operator delete(void* ptr, size_t) noexcept -> void {
+	std::free(ptr);
+}
+
+auto operator delete[](void* ptr) noexcept -> void {
+	std::free(ptr);
+}
+
+auto operator delete[](void* ptr, size_t) noexcept -> void {
+	std::free(ptr);
+}
+
+// Keeps the compiler from optimising away a result the benchmark doesn't otherwise use.
+template<typename T>
+auto doNotOptimize(const T& value) -> void {
+#if defined(_MSC_VER)
+	static volatile const T* sink;
+	sink = &value;
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+struct BenchmarkResult
+{
+	double nanoseconds = 0;
+	double allocations = 0;
+};
+
+// Runs func iterations times after a warm up, and prints and returns the time and allocations per iteration.
+template<typename TFunc>
+auto runBenchmark(const char* name, size_t iterations, TFunc&& func) -> BenchmarkResult {
+	for (size_t i = 0; i < iterations / 10 + 1; ++i) func();
+
+	auto const allocationsBefore = allocationCount;
+	auto const start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < iterations; ++i) func();
+
+	auto const elapsed = std::chrono::steady_clock::now() - start;
+
+	BenchmarkResult result;
+	result.nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+	result.allocations = static_cast<double>(allocationCount - allocationsBefore) / iterations;
+
+	std::printf("%-48s %10.1f ns %8.2f allocations\n", name, result.nanoseconds, result.allocations);
+	return result;
+}
@@ -0,0 +1,47 @@
+#include "Benchmark.h"
+#include "EventSystem.h"
+#include "Events.h"
+
+// Dispatch of a typical Kill event through EventSystem::handle.
+// The deep copy case measures what dispatch used to cost on top, when each ServerEvent got its own copy of the
+// event's JSON document.
+
+static constexpr std::string_view killEvent = R"({"Name":"Kill","ContractSessionId":"2519721512351239876-5ad1c0d3-3f6e-4f8e-9f2e-2b0e4a3c1d77",)"
+	R"("ContractId":"00000000-0000-0000-0000-000000000200","Timestamp":312.8734,"Value":{)"
+	R"("RepositoryId":"c3d5a8e4-0b6f-4c0d-a1a8-7bb39b22a3f1","ActorId":2785112064,"ActorName":"Sebastian Sato",)"
+	R"("ActorType":1,"KillType":1,"KillContext":3,"KillClass":"unknown","Accident":false,"WeaponSilenced":true,)"
+	R"("Explosive":false,"ExplosionType":0,"Projectile":false,"Sniper":false,"IsHeadshot":true,"IsTarget":false,)"
+	R"("ThroughWall":false,"BodyPartId":0,"TotalDamage":100000.0,"IsMoving":false,"RoomId":1067,)"
+	R"("ActorPosition":"-21.334, -48.811, 0.012","HeroPosition":"-20.913, -52.377, 0.004","DamageEvents":[],)"
+	R"("PlayerId":-1,"OutfitRepositoryId":"08022e2c-4954-4b63-b632-3ac50d018292","OutfitIsHitmanSuit":true,)"
+	R"("KillMethodBroad":"pistol","KillMethodStrict":"","EvergreenRarity":-1,"History":[],)"
+	R"("KillItemRepositoryId":"73875794-5a86-410e-84a4-1b5b2f7e5a54","KillItemInstanceId":"d2d9f6f3-0b94-4e0a-9a4c-6d4b8b8c1f10",)"
+	R"("KillItemCategory":"pistol"}})";
+
+int main() {
+	EventSystem events;
+	size_t kills = 0;
+
+	// Reads a few fields, like most of the real handlers
+	events.listen<Events::Kill>([&kills](const ServerEvent<Events::Kill>& ev) {
+		if (!ev.Value.IsTarget && !ev.Value.RepositoryId.empty()) ++kills;
+		doNotOptimize(ev.Value.KillMethodBroad);
+	});
+
+	constexpr size_t iterations = 200000;
+
+	runBenchmark("RawEvent::read + EventSystem::handle (Kill)", iterations, [&] {
+		auto const raw = RawEvent::read(killEvent);
+		doNotOptimize(events.handle(raw));
+	});
+
+	auto const document = nlohmann::json::parse(killEvent);
+
+	runBenchmark("Deep copy of the Kill event's JSON document", iterations, [&] {
+		auto copy = document;
+		doNotOptimize(copy);
+	});
+
+	doNotOptimize(kills);
+	return 0;
+}
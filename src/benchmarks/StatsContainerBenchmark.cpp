@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <ranges>
+#include <set>
+#include <unordered_set>
+#include <vector>
+#include "Benchmark.h"
+#include "Stats.h"
+
+// Per-contract stat sets in Stats, against the same sets in std::set and std::map.
+// Measures filling them with a typical contract's worth of IDs followed by the NewContract reset, and the witness and
+// spotted by filtering in Stealthometer::GetSilentAssassinStatus.
+
+// The sets and maps Stats used to have, keyed by RepoId like now
+struct NodeStats
+{
+	struct
+	{
+		std::set<RepoId> targets;
+		std::set<RepoId> nonTargets;
+		std::set<RepoId> proxyDeaths;
+		std::map<RepoId, std::map<RepoId, bool>> noticedKillInfos;
+	} kills;
+
+	struct
+	{
+		std::set<RepoId> uniqueBodiesFound;
+		std::map<RepoId, std::map<RepoId, bool>> foundMurderedInfos;
+	} bodies;
+
+	std::set<RepoId> witnesses;
+	std::set<RepoId> spottedBy;
+	std::set<RepoId> targetsSpottedBy;
+	std::set<RepoId> targetBodyWitnesses;
+	std::set<RepoId> targetKillNoticers;
+	std::set<RepoId> disguisesBlown;
+	std::map<RepoId, ItemInfo> itemsObtained;
+	std::map<RepoId, ItemInfo> itemsDisposed;
+};
+
+// What a contract typically ends up with - all well under the inline capacity
+struct ContractIds
+{
+	std::vector<RepoId> targets;
+	std::vector<RepoId> nonTargets;
+	std::vector<RepoId> witnesses;
+	std::vector<RepoId> spottedBy;
+	std::vector<RepoId> bodies;
+	std::vector<RepoId> items;
+};
+
+static auto makeContractIds() -> ContractIds {
+	std::mt19937_64 random(42);
+	auto ids = [&random](size_t count) {
+		std::vector<RepoId> result(count);
+		for (auto& id : result) id = RepoId{random(), random()};
+		return result;
+	};
+
+	ContractIds contract;
+	contract.targets = ids(2);
+	contract.nonTargets = ids(4);
+	contract.witnesses = ids(7);
+	contract.spottedBy = ids(9);
+	contract.bodies = ids(5);
+	contract.items = ids(12);
+
+	// Some witnesses were later killed
+	contract.witnesses[0] = contract.nonTargets[0];
+	contract.spottedBy[0] = contract.nonTargets[1];
+	contract.spottedBy[1] = contract.targets[0];
+	return contract;
+}
+
+template<typename TStats>
+static auto fill(TStats& stats, const ContractIds& contract) -> void {
+	for (auto id : contract.targets) stats.kills.targets.emplace(id);
+	for (auto id : contract.nonTargets) stats.kills.nonTargets.emplace(id);
+	for (auto id : contract.witnesses) stats.witnesses.emplace(id);
+	for (auto id : contract.spottedBy) stats.spottedBy.emplace(id);
+	for (auto id : contract.bodies) stats.bodies.uniqueBodiesFound.emplace(id);
+	for (auto id : contract.items) stats.itemsObtained.emplace(id, ItemInfo{});
+	stats.targetsSpottedBy.emplace(contract.targets[0]);
+	stats.disguisesBlown.emplace(contract.items[0]);
+}
+
+// Same filtering as GetSilentAssassinStatus
+template<typename TStats>
+static auto countNonTargetWitnesses(const TStats& stats, const std::unordered_set<RepoId>& targets) -> ptrdiff_t {
+	auto isKilled = [&stats](RepoId id) {
+		return stats.kills.targets.contains(id) || stats.kills.nonTargets.contains(id);
+	};
+	auto isTarget = [&targets](RepoId id) {
+		return targets.contains(id);
+	};
+	auto witnessesNonTarget = stats.witnesses | std::views::filter(std::not_fn(isKilled)) | std::views::filter(std::not_fn(isTarget));
+	auto spottedByNonTarget = stats.spottedBy | std::views::filter(std::not_fn(isKilled)) | std::views::filter(std::not_fn(isTarget));
+	return std::ranges::distance(witnessesNonTarget) + std::ranges::distance(spottedByNonTarget);
+}
+
+int main() {
+	auto const contract = makeContractIds();
+	std::unordered_set<RepoId> targets(contract.targets.begin(), contract.targets.end());
+
+	constexpr size_t contracts = 100000;
+	constexpr size_t evaluations = 2000000;
+
+	// Allocated like Stealthometer's, as a member of a larger heap object
+	auto contractBuffer = std::make_unique<std::array<std::byte, 64 * 1024>>();
+	std::pmr::monotonic_buffer_resource contractMemory { contractBuffer->data(), contractBuffer->size() };
+	Stats stats { &contractMemory };
+
+	runBenchmark("Stats: fill + NewContract reset", contracts, [&] {
+		fill(stats, contract);
+		doNotOptimize(stats);
+		std::destroy_at(&stats);
+		contractMemory.release();
+		std::construct_at(&stats, &contractMemory);
+	});
+
+	auto nodeStats = std::make_unique<NodeStats>();
+
+	runBenchmark("std::set: fill + NewContract reset", contracts, [&] {
+		fill(*nodeStats, contract);
+		doNotOptimize(*nodeStats);
+		*nodeStats = NodeStats();
+	});
+
+	fill(stats, contract);
+	fill(*nodeStats, contract);
+
+	if (countNonTargetWitnesses(stats, targets) != countNonTargetWitnesses(*nodeStats, targets)) {
+		std::printf("results differ\n");
+		return 1;
+	}
+
+	runBenchmark("Stats: silent assassin witness filtering", evaluations, [&] {
+		doNotOptimize(countNonTargetWitnesses(stats, targets));
+	});
+
+	runBenchmark("std::set: silent assassin witness filtering", evaluations, [&] {
+		doNotOptimize(countNonTargetWitnesses(*nodeStats, targets));
+	});
+
+	return 0;
+}
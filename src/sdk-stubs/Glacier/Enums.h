@@ -0,0 +1,253 @@
+#pragma once
+
+// Stand-in for the SDK's Glacier/Enums.h, so the tests and benchmarks build without the game SDK.
+// Only declares what the mod's portable code names. Values don't match the game's.
+
+enum class EGameTension
+{
+	EGT_Undefined,
+	EGT_Ambient,
+	EGT_AlertedLow,
+	EGT_AlertedHigh,
+	EGT_Hunting,
+	EGT_Searching,
+	EGT_Arrest,
+	EGT_Combat,
+	EGT_Agitated,
+};
+
+enum class EDeathContext
+{
+	eDC_UNDEFINED,
+	eDC_NOT_HERO,
+	eDC_HIDDEN,
+	eDC_ACCIDENT,
+	eDC_MURDER,
+};
+
+enum class EDeathType
+{
+	eDT_UNDEFINED,
+	eDT_PACIFY,
+	eDT_KILL,
+	eDT_BLOODY_KILL,
+};
+
+enum class EKillType
+{
+	EKillType_Undefined,
+	EKillType_Throw,
+	EKillType_Fiberwire,
+	EKillType_PistolExecute,
+	EKillType_ItemTakeOutFront,
+	EKillType_ItemTakeOutBack,
+	EKillType_ChokeOut,
+	EKillType_SnapNeck,
+	EKillType_KnockOut,
+	EKillType_Push,
+	EKillType_Pull,
+};
+
+enum class EActorType
+{
+	eAT_Civilian,
+	eAT_Guard,
+	eAT_Hitman,
+	eAT_Last,
+};
+
+enum class ECompiledBehaviorType
+{
+	BT_Invalid = -1,
+	BT_AbandonOrder,
+	BT_Act,
+	BT_AgitatedBystander,
+	BT_AgitatedGuard,
+	BT_AgitatedPatrol,
+	BT_Aim,
+	BT_AimReaction,
+	BT_AlertedDebug,
+	BT_AlertedStand,
+	BT_AmbientItemUse,
+	BT_AmbientLook,
+	BT_AmbientStand,
+	BT_AmbientWalk,
+	BT_AttentionToPerson,
+	BT_BEHAVIORS_END,
+	BT_COMMANDS_END,
+	BT_CautiousGuardVIP,
+	BT_CautiousSearchPosition,
+	BT_CautiousVIP,
+	BT_CheckLastPosition,
+	BT_CloseCombat,
+	BT_CompleteOrder,
+	BT_ConditionScope,
+	BT_ConditionedConfiguredAct,
+	BT_ConditionedConfiguredSpeak,
+	BT_ConfiguredAct,
+	BT_ConfiguredSpeak,
+	BT_Controlled,
+	BT_ControlledFormationMove,
+	BT_Conversation,
+	BT_CopyKnownLocation,
+	BT_CoverFightSeasonTwo,
+	BT_CreateOrJoinSituation,
+	BT_CrowdAmbientStand,
+	BT_CureInfected,
+	BT_CuriousBystander,
+	BT_CuriousIdle,
+	BT_DeadBodyBystander,
+	BT_DeadBodyInvestigate,
+	BT_DefendVIP,
+	BT_DeliverWeapon,
+	BT_DragDeadBody,
+	BT_Drop,
+	BT_Dummy,
+	BT_Dummy2,
+	BT_EnterInfected,
+	BT_Error,
+	BT_Escalate,
+	BT_Escort,
+	BT_EscortOut,
+	BT_EscortSearch,
+	BT_ExpireAllEvents,
+	BT_ExpireArrestReasons,
+	BT_ExpireEvent,
+	BT_ExpireEvents,
+	BT_ExpireGoal,
+	BT_ExpireGoalOf,
+	BT_ExpireSharedEvent,
+	BT_Flee,
+	BT_FollowHitman,
+	BT_FollowTargetActualPosition,
+	BT_FollowTargetKnownPosition,
+	BT_ForceActorToJoinSituation,
+	BT_FormationMove,
+	BT_GetOutfit,
+	BT_GotoPhase,
+	BT_GrabItem,
+	BT_GuardDeadBody,
+	BT_HeroEscort,
+	BT_Holster,
+	BT_HomeAttackOrigin,
+	BT_IgnoreAllDistractionsExceptTheNewest,
+	BT_IgnoreDistractions,
+	BT_InfectedAssignToFollowPlayer,
+	BT_InfectedConfused,
+	BT_InfectedRemoveFromFollowPlayer,
+	BT_InvestigateWeapon,
+	BT_JoinSituation,
+	BT_JoinSituationWithActor,
+	BT_JumpyInvestigation,
+	BT_LeadEscort,
+	BT_LeadEscort2,
+	BT_LeaveDistractionAssistantRole,
+	BT_LeaveDistractionAssitingGuardRole,
+	BT_LeaveSituation,
+	BT_LimitedSearch,
+	BT_LockdownWarning,
+	BT_Log,
+	BT_Match,
+	BT_MoveAwayFromCloseCombat,
+	BT_MoveInCover,
+	BT_MoveTo,
+	BT_MoveToAimingAndPlayCombatPositionAct,
+	BT_MoveToAndPlayCombatPositionAct,
+	BT_MoveToCloseCombat,
+	BT_MoveToCover,
+	BT_MoveToInteraction,
+	BT_MoveToLocation,
+	BT_MoveToNPC,
+	BT_MoveToPosition,
+	BT_MoveToRandomNeighbourNode,
+	BT_MoveToRandomNeighbourNodeAiming,
+	BT_MoveToTargetActualPosition,
+	BT_MoveToTargetKnownPosition,
+	BT_Patrol,
+	BT_PerceptibleEntityNotifyInvestigated,
+	BT_PerceptibleEntityNotifyInvestigating,
+	BT_PerceptibleEntityNotifyReacted,
+	BT_PerceptibleEntityNotifyTerminate,
+	BT_PerceptibleEntityNotifyWillReact,
+	BT_PickUpItem,
+	BT_Pickup,
+	BT_PlayAct,
+	BT_PlayAnimation,
+	BT_PlayConversation,
+	BT_PlayJumpyReaction,
+	BT_PlayReaction,
+	BT_ProtoApproachSearchArea,
+	BT_ProtoSearchIdle,
+	BT_ProtoSearchPosition,
+	BT_PutDownItem,
+	BT_RadioCall,
+	BT_Random,
+	BT_RecoverUnconscious,
+	BT_RenewEvent,
+	BT_RenewGoal,
+	BT_RenewGoalOf,
+	BT_RenewSharedEvent,
+	BT_Reposition,
+	BT_RequestSuitcaseAssistanceFaceToFace,
+	BT_RequestSuitcaseAssistanceOverRadio,
+	BT_RideTheLightning,
+	BT_RunToHelp,
+	BT_Scared,
+	BT_Search,
+	BT_SentryCheckItem,
+	BT_SentryFrisk,
+	BT_SentryIdle,
+	BT_SentryWarning,
+	BT_Sequence,
+	BT_SetDialogSwitch_NPCID,
+	BT_SetDistracted,
+	BT_SetEventHandled,
+	BT_SetTension,
+	BT_Shoot,
+	BT_ShootFromPosition,
+	BT_ShootTarget,
+	BT_SickActInfected,
+	BT_SimpleReaction,
+	BT_SituationAct,
+	BT_SituationApproach,
+	BT_SituationConversation,
+	BT_SituationFace,
+	BT_SituationGetHelp,
+	BT_SituationJumpTo,
+	BT_SituationMoveTo,
+	BT_Smart,
+	BT_Speak,
+	BT_SpeakCustomOrDefaultDistractionAckSoundDef,
+	BT_SpeakCustomOrDefaultDistractionInvestigationSoundDef,
+	BT_SpeakCustomOrDefaultDistractionStndSoundDef,
+	BT_SpeakTest,
+	BT_SpeakWait,
+	BT_SpeakWaitWithFallbackIfAlone,
+	BT_StandAndAim,
+	BT_StandAndShoot,
+	BT_StandOffArrest,
+	BT_StandOffReposition,
+	BT_StartDynamicEnforcer,
+	BT_StartRangeBasedDynamicEnforcer,
+	BT_StashItem,
+	BT_StopDynamicEnforcer,
+	BT_StopRangeBasedDynamicEnforcer,
+	BT_StopRangeBasedDynamicEnforcerForLocation,
+	BT_StunnedByFlashGrenade,
+	BT_TestFlashbangGrenadeThrow,
+	BT_TransferKnownObjectPositions,
+	BT_TriggerAlarm,
+	BT_TriggerSpotted,
+	BT_UpdateKnownLocation,
+	BT_VIPSafeRoomTrespasser,
+	BT_VIPScared,
+	BT_Wait,
+	BT_WaitBasedOnDistanceToTarget,
+	BT_WaitForConfiguredAct,
+	BT_WaitForDialog,
+	BT_WaitForItemHandled,
+	BT_WaitForStanding,
+	BT_WakeUpUnconscious,
+	BT_WitnessAttack,
+	BT_Count,
+};
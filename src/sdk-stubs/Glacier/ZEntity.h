@@ -0,0 +1,6 @@
+#pragma once
+
+// Stand-in for the SDK's Glacier/ZEntity.h, see Glacier/Enums.h.
+
+template<typename T>
+class TEntityRef;
@@ -0,0 +1,10 @@
+#pragma once
+
+// Stand-in for the SDK's Glacier/ZMath.h, see Glacier/Enums.h.
+
+struct SVector3
+{
+	float x = 0;
+	float y = 0;
+	float z = 0;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+// Stand-in for the SDK's logger, see Glacier/Enums.h. Messages are discarded.
+class Logger
+{
+public:
+	template<typename... TArgs>
+	static auto Debug(TArgs&&...) -> void {}
+
+	template<typename... TArgs>
+	static auto Info(TArgs&&...) -> void {}
+
+	template<typename... TArgs>
+	static auto Warn(TArgs&&...) -> void {}
+
+	template<typename... TArgs>
+	static auto Error(TArgs&&...) -> void {}
+};
@@ -0,0 +1,113 @@
+#include <cstdio>
+#include <string_view>
+#include <utility>
+#include "DerivedStats.h"
+#include "EventSystem.h"
+
+// Replays the events of a session through the same dependency tracking as Stealthometer::HandleEvent, checking a derived
+// stat which isn't recomputed always still matches a fresh computation, as UpdateDisplayStats asserts in debug builds.
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			++failures; \
+		} \
+	} while (false)
+
+static constexpr std::string_view session[] = {
+	"ContractStart",
+	"IntroCutEnd",
+	"StartingSuit",
+	"AmbientChanged",
+	"ItemPickedUp",
+	"ItemPickedUp",
+	"Disguise",
+	"Trespassing",
+	"Agility_Start",
+	"Drain_Pipe_Climbed",
+	"Door_Unlocked",
+	"ItemThrown",
+	"Pacify",
+	"Unnoticed_Pacified",
+	"BodyHidden",
+	"AmbientChanged",
+	"Spotted",
+	"Witnesses",
+	"ShotsFired",
+	"Kill",
+	"Unnoticed_Kill",
+	"DeadBodySeen",
+	"BodyFound",
+	"DisguiseBlown",
+	"ItemDropped",
+	"setpieces",
+	"SecuritySystemRecorder",
+	"HoldingIllegalWeapon",
+	"TargetEliminated",
+	"ExitGate",
+	"ContractEnd",
+	"CollectorUpdate",
+	"NotARealEvent",
+};
+
+// Stand-in for Stats - a counter per field group, bumped by each event for every group its handler modifies
+struct FieldCounters
+{
+	int counts[12] = {};
+
+	auto modify(StatFields fields) -> void {
+		for (auto i = 0; i < 12; ++i)
+			if (!!(fields & static_cast<StatFields>(1 << i))) ++this->counts[i];
+	}
+
+	// Stand-in for GetSilentAssassinStatus, reading only the fields it depends on
+	auto compute(StatFields dependencies) const -> int {
+		auto value = 0;
+		for (auto i = 0; i < 12; ++i)
+			if (!!(dependencies & static_cast<StatFields>(1 << i))) value = value * 31 + this->counts[i];
+		return value;
+	}
+};
+
+int main() {
+	// Replay, accumulating changed fields like HandleEvent and updating once per event like UpdateDisplayStats
+	FieldCounters fields;
+	DerivedStat<int> silentAssassinStatus { silentAssassinStatFields };
+	auto const compute = [&] { return fields.compute(silentAssassinStatFields); };
+	auto changed = StatFields::All;
+	auto events = 0;
+
+	CHECK(silentAssassinStatus.update(std::exchange(changed, StatFields::None), compute));
+
+	for (auto const name : session) {
+		auto const& entry = lookupEventName(name);
+
+		if (entry.type == EventNameType::Event) {
+			auto const modified = getEventStatFields(entry.event);
+			fields.modify(modified);
+			changed |= modified;
+			++events;
+		}
+
+		silentAssassinStatus.update(std::exchange(changed, StatFields::None), compute);
+		CHECK(silentAssassinStatus.get() == compute());
+	}
+
+	std::printf("silent assassin status recomputed %d times for %d events\n", silentAssassinStatus.getRecomputeCount(), events);
+	CHECK(silentAssassinStatus.getRecomputeCount() < events);
+
+	// Changes it doesn't depend on don't recompute it
+	fields.modify(StatFields::Items | StatFields::Misc);
+	CHECK(!silentAssassinStatus.update(StatFields::Items | StatFields::Misc, compute));
+	CHECK(silentAssassinStatus.get() == compute());
+
+	// NewContract invalidates it, so the next update recomputes whatever changed
+	silentAssassinStatus.reset();
+	CHECK(silentAssassinStatus.update(StatFields::None, compute));
+	CHECK(!silentAssassinStatus.update(StatFields::Items | StatFields::Misc, compute));
+
+	return failures ? 1 : 0;
+}
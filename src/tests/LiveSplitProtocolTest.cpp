@@ -0,0 +1,508 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "BoundedQueue.h"
+#include "LiveSplitProtocol.h"
+
+#ifdef _WIN32
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using SOCKET = int;
+constexpr SOCKET INVALID_SOCKET = -1;
+static auto closesocket(SOCKET sock) -> int { return close(sock); }
+#endif
+
+#ifdef MSG_NOSIGNAL
+// A send to a closed connection fails rather than raising SIGPIPE
+constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+constexpr int sendFlags = 0;
+#endif
+
+// Drives LiveSplitWriter, the part of LiveSplitClient that batches and sends, against a stand-in for LiveSplit Server
+// over loopback TCP. Messages from several producers are drained oldest first, superseded game times are dropped,
+// getcurrenttimerphase responses are reconciled with the predicted phase, and what a failed connection didn't send is
+// sent on the next one. LiveSplitClient only adds the Win32 event and thread which run the writer.
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			++failures; \
+		} \
+	} while (false)
+
+static auto sendAll(SOCKET sock, std::string_view data) -> bool {
+	while (!data.empty()) {
+		auto const sent = ::send(sock, data.data(), static_cast<int>(data.size()), sendFlags);
+		if (sent <= 0) return false;
+		data.remove_prefix(sent);
+	}
+	return true;
+}
+
+// Reads a line, without its line ending, keeping anything after it in buffer for the next one
+static auto readLine(SOCKET sock, std::string& buffer) -> std::optional<std::string> {
+	auto end = buffer.find('\n');
+	while (end == std::string::npos) {
+		char chunk[64];
+		auto const received = ::recv(sock, chunk, sizeof(chunk), 0);
+		if (received <= 0) return std::nullopt;
+		buffer.append(chunk, received);
+		end = buffer.find('\n');
+	}
+
+	auto line = buffer.substr(0, end);
+	buffer.erase(0, end + 1);
+	if (line.ends_with('\r')) line.pop_back();
+	return line;
+}
+
+// Accepts connections one after another and plays LiveSplit Server for a run with a number of splits, recording every
+// line received
+class StandInServer
+{
+public:
+	StandInServer(int splitCount, int connectionCount = 1) : splitCount(splitCount), connectionCount(connectionCount) {
+		this->listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+		sockaddr_in address = {};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		address.sin_port = 0;
+		bind(this->listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+		listen(this->listener, this->connectionCount);
+
+		socklen_t addressSize = sizeof(address);
+		getsockname(this->listener, reinterpret_cast<sockaddr*>(&address), &addressSize);
+		this->port = ntohs(address.sin_port);
+
+		this->thread = std::thread([this] { this->serve(); });
+	}
+
+	~StandInServer() {
+		if (this->thread.joinable()) this->thread.join();
+		closesocket(this->listener);
+	}
+
+	auto getPort() const -> uint16_t { return this->port; }
+
+	// Waits for the client to make and close all its connections, then returns what it sent
+	auto finish() -> const std::vector<std::string>& {
+		this->thread.join();
+		return this->lines;
+	}
+
+private:
+	auto serve() -> void {
+		for (auto i = 0; i < this->connectionCount; ++i) {
+			auto const sock = accept(this->listener, nullptr, nullptr);
+			if (sock == INVALID_SOCKET) return;
+			this->serveConnection(sock);
+			closesocket(sock);
+		}
+	}
+
+	auto serveConnection(SOCKET sock) -> void {
+		std::string buffer;
+		while (auto line = readLine(sock, buffer)) {
+			this->lines.push_back(*line);
+			auto const command = std::string_view(*line).substr(0, line->find(' '));
+
+			if (command == "getcurrenttimerphase") {
+				// In two pieces, as a response can arrive
+				static constexpr std::string_view phaseNames[] = {"NotRunning", "Running", "Ended", "Paused"};
+				auto const response = std::string(phaseNames[static_cast<size_t>(this->phase)]) + "\r\n";
+				sendAll(sock, std::string_view(response).substr(0, 3));
+				std::this_thread::sleep_for(std::chrono::milliseconds(5));
+				sendAll(sock, std::string_view(response).substr(3));
+			}
+			else this->apply(command);
+		}
+	}
+
+	auto apply(std::string_view command) -> void {
+		using enum eLiveSplitTimerPhase;
+
+		if (command == "starttimer" || (command == "startorsplit" && this->phase == NotRunning)) {
+			if (this->phase == NotRunning) this->phase = Running, this->split = 0;
+		}
+		else if (command == "split" || command == "startorsplit") {
+			if (this->phase == Running && ++this->split == this->splitCount) this->phase = Ended;
+		}
+		else if (command == "unsplit") {
+			if (this->phase != NotRunning && this->split > 0) this->phase = Running, --this->split;
+		}
+		else if (command == "pause") {
+			if (this->phase == Running) this->phase = Paused;
+		}
+		else if (command == "resume") {
+			if (this->phase == Paused) this->phase = Running;
+		}
+		else if (command == "reset") {
+			this->phase = NotRunning;
+		}
+	}
+
+	SOCKET listener = INVALID_SOCKET;
+	uint16_t port = 0;
+	std::thread thread;
+	std::vector<std::string> lines;
+	eLiveSplitTimerPhase phase = eLiveSplitTimerPhase::NotRunning;
+	int splitCount;
+	int connectionCount;
+	int split = 0;
+};
+
+static auto connectTo(uint16_t port) -> SOCKET {
+	auto const sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(port);
+
+	if (connect(sock, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+		closesocket(sock);
+		return INVALID_SOCKET;
+	}
+	return sock;
+}
+
+// The writer's connection over a loopback socket, which can be made to fail like a timed out one
+class TestConnection : public LiveSplitConnection
+{
+public:
+	explicit TestConnection(uint16_t port) : sock(connectTo(port))
+	{ }
+
+	~TestConnection() override {
+		this->close();
+	}
+
+	auto send(std::string_view data) -> int override {
+		if (this->sendLimit == 0 || this->sock == INVALID_SOCKET) return -1;
+
+		data = data.substr(0, this->sendLimit);
+		auto const sent = ::send(this->sock, data.data(), static_cast<int>(data.size()), sendFlags);
+		if (sent > 0 && this->sendLimit != unlimited) this->sendLimit -= sent;
+		return sent;
+	}
+
+	auto recv(char* buffer, size_t size) -> int override {
+		if (this->failRecv || this->sock == INVALID_SOCKET) return -1;
+		return ::recv(this->sock, buffer, static_cast<int>(size), 0);
+	}
+
+	auto isOpen() const { return this->sock != INVALID_SOCKET; }
+
+	auto close() -> void {
+		if (this->sock != INVALID_SOCKET) closesocket(this->sock);
+		this->sock = INVALID_SOCKET;
+	}
+
+	static constexpr size_t unlimited = std::numeric_limits<size_t>::max();
+
+	// Bytes which can be sent before sends fail
+	size_t sendLimit = unlimited;
+	// Fail receives, like a response timing out
+	bool failRecv = false;
+
+private:
+	SOCKET sock = INVALID_SOCKET;
+};
+
+static auto testWireFormat() -> void {
+	std::string buffer;
+	ClientMessage(eClientMessage::StartTimer).appendTo(buffer);
+	ClientMessage(eClientMessage::SetGameTime, "12.5").appendTo(buffer);
+	ClientMessage(eClientMessage::GetCurrentTimerPhase).appendTo(buffer);
+	CHECK(buffer == "starttimer\nsetgametime 12.5\ngetcurrenttimerphase\n");
+
+	CHECK(ClientMessage(eClientMessage::SwitchTo, "gametime").toString() == "switchto gametime");
+	CHECK(ClientMessage(eClientMessage::StartOrSplit).toString() == "startorsplit");
+
+	// Arguments are held inline, and cut off if they don't fit
+	auto const longArgs = std::string(ClientMessage::MaxArgsSize + 8, '1');
+	CHECK(ClientMessage(eClientMessage::SetGameTime, longArgs).args() == std::string_view(longArgs).substr(0, ClientMessage::MaxArgsSize));
+
+	CHECK(parseTimerPhase("NotRunning") == eLiveSplitTimerPhase::NotRunning);
+	CHECK(parseTimerPhase("Running") == eLiveSplitTimerPhase::Running);
+	CHECK(parseTimerPhase("Ended") == eLiveSplitTimerPhase::Ended);
+	CHECK(parseTimerPhase("Paused") == eLiveSplitTimerPhase::Paused);
+	CHECK(!parseTimerPhase("running"));
+	CHECK(!parseTimerPhase(""));
+}
+
+static auto testQueueWhenFull() -> void {
+	BoundedQueue<ClientMessage, 4> queue;
+
+	for (auto i = 0; i < 4; ++i)
+		CHECK(queue.push(ClientMessage(eClientMessage::SetGameTime, std::to_string(i))));
+
+	// Not moved from, so the caller can still log it
+	ClientMessage rejected(eClientMessage::Split, "rejected");
+	CHECK(!queue.push(std::move(rejected)));
+	CHECK(rejected.args() == "rejected");
+
+	for (auto i = 0; i < 4; ++i) {
+		auto const message = queue.pop();
+		CHECK(message && message->args() == std::to_string(i));
+	}
+	CHECK(!queue.pop());
+}
+
+// Producers enqueue concurrently while the writer drains and sends. Each producer's messages must reach the server in
+// the order it sent them.
+static auto testProducerOrdering() -> void {
+	constexpr int producerCount = 4;
+	constexpr int messagesPerProducer = 500;
+
+	StandInServer server(1);
+	TestConnection connection(server.getPort());
+	CHECK(connection.isOpen());
+	if (!connection.isOpen()) return;
+
+	LiveSplitWriter writer;
+	writer.onConnected();
+	std::atomic<int> producersDone = 0;
+	std::vector<std::thread> producers;
+
+	for (auto producer = 0; producer < producerCount; ++producer) {
+		producers.emplace_back([&writer, &producersDone, producer] {
+			for (auto i = 0; i < messagesPerProducer; ++i) {
+				ClientMessage message(eClientMessage::SwitchTo, std::to_string(producer) + "." + std::to_string(i));
+				while (!writer.enqueue(std::move(message))) std::this_thread::yield();
+			}
+			++producersDone;
+		});
+	}
+
+	while (true) {
+		auto const done = producersDone == producerCount;
+		CHECK(writer.write(connection));
+		if (done) break;
+		std::this_thread::yield();
+	}
+
+	for (auto& producer : producers) producer.join();
+
+	// Answered after everything sent before it
+	CHECK(writer.queryTimerPhase(connection) == eLiveSplitTimerPhase::NotRunning);
+	connection.close();
+
+	auto const& lines = server.finish();
+	CHECK(lines.size() == producerCount * messagesPerProducer + 1);
+	CHECK(lines.back() == "getcurrenttimerphase");
+
+	std::vector<int> next(producerCount, 0);
+	for (auto it = lines.begin(); it != lines.end() - 1; ++it) {
+		int producer = -1, i = -1;
+		CHECK(std::sscanf(it->c_str(), "switchto %d.%d", &producer, &i) == 2);
+		if (producer < 0 || producer >= producerCount) continue;
+		CHECK(i == next[producer]);
+		next[producer] = i + 1;
+	}
+	CHECK(std::ranges::all_of(next, [](int n) { return n == messagesPerProducer; }));
+}
+
+// A game time still waiting in the batch is replaced by a newer one, but not across other commands
+static auto testGameTimeSuperseded() -> void {
+	StandInServer server(1);
+	TestConnection connection(server.getPort());
+	LiveSplitWriter writer;
+	writer.onConnected();
+
+	for (auto const gameTime : {"1", "2"}) CHECK(writer.enqueue(ClientMessage(eClientMessage::SetGameTime, gameTime)));
+	CHECK(writer.enqueue(ClientMessage(eClientMessage::StartTimer)));
+	for (auto const gameTime : {"3", "4", "5"}) CHECK(writer.enqueue(ClientMessage(eClientMessage::SetGameTime, gameTime)));
+	CHECK(writer.write(connection));
+
+	// Nothing is left batched to replace once it's been sent
+	CHECK(writer.enqueue(ClientMessage(eClientMessage::SetGameTime, "6")));
+	CHECK(writer.write(connection));
+	connection.close();
+
+	std::vector<std::string> const expected = {"setgametime 2", "starttimer", "setgametime 5", "setgametime 6"};
+	CHECK(server.finish() == expected);
+}
+
+// A pause which only applies while the timer is running waits on a timer phase query. When the response times out
+// the pause stays pending, ahead of anything queued after it, and is retried on the next connection.
+static auto testPendingRetriedAfterReconnect() -> void {
+	StandInServer server(1, 2);
+	LiveSplitWriter writer;
+
+	{
+		TestConnection connection(server.getPort());
+		writer.onConnected();
+		CHECK(writer.enqueue(ClientMessage(eClientMessage::StartTimer)));
+		CHECK(writer.write(connection));
+
+		ClientMessage pause(eClientMessage::Pause);
+		pause.onlyIfRunning = true;
+		CHECK(writer.enqueue(std::move(pause)));
+		CHECK(writer.enqueue(ClientMessage(eClientMessage::Split)));
+
+		connection.failRecv = true;
+		CHECK(!writer.write(connection));
+		CHECK(!writer.getTimerPhase());
+	}
+
+	TestConnection connection(server.getPort());
+	writer.onConnected();
+	CHECK(writer.isReconcileDue());
+	CHECK(writer.write(connection));
+	connection.close();
+
+	std::vector<std::string> const expected = {"starttimer", "getcurrenttimerphase", "getcurrenttimerphase", "pause", "split"};
+	CHECK(server.finish() == expected);
+}
+
+// When the batch ahead of a timer phase query can't be sent, the query is removed and the batch kept whole for the
+// next connection, where it's sent once with a single query after it
+static auto testFailedQueryRemoved() -> void {
+	StandInServer server(1, 2);
+	LiveSplitWriter writer;
+
+	{
+		TestConnection connection(server.getPort());
+		writer.onConnected();
+		connection.sendLimit = 0;
+
+		ClientMessage pause(eClientMessage::Pause);
+		pause.onlyIfRunning = true;
+		CHECK(writer.enqueue(ClientMessage(eClientMessage::StartTimer)));
+		CHECK(writer.enqueue(std::move(pause)));
+		CHECK(!writer.write(connection));
+	}
+
+	TestConnection connection(server.getPort());
+	writer.onConnected();
+	CHECK(writer.write(connection));
+	CHECK(writer.getTimerPhase() == eLiveSplitTimerPhase::Running);
+	connection.close();
+
+	std::vector<std::string> const expected = {"starttimer", "getcurrenttimerphase", "pause"};
+	CHECK(server.finish() == expected);
+}
+
+// A message cut off by a failed send would be garbage to the server, so it's sent again whole on the next connection,
+// followed by the rest of the batch
+static auto testPartialSendResent() -> void {
+	StandInServer server(1, 2);
+	LiveSplitWriter writer;
+
+	{
+		TestConnection connection(server.getPort());
+		writer.onConnected();
+		connection.sendLimit = std::string_view("starttimer\nsp").size();
+
+		CHECK(writer.enqueue(ClientMessage(eClientMessage::StartTimer)));
+		CHECK(writer.enqueue(ClientMessage(eClientMessage::Split)));
+		CHECK(writer.enqueue(ClientMessage(eClientMessage::SetGameTime, "5")));
+		CHECK(!writer.write(connection));
+	}
+
+	TestConnection connection(server.getPort());
+	writer.onConnected();
+	CHECK(writer.write(connection));
+	connection.close();
+
+	std::vector<std::string> const expected = {"starttimer", "split", "setgametime 5"};
+	CHECK(server.finish() == expected);
+}
+
+// The writer predicts the phase after each command and reconciles it with the server. Predictions hold except for the
+// last split, which ends the run - why the writer queries straight after splits.
+static auto testTimerPhaseReconcile() -> void {
+	using enum eLiveSplitTimerPhase;
+
+	StandInServer server(2);
+	TestConnection connection(server.getPort());
+	CHECK(connection.isOpen());
+	if (!connection.isOpen()) return;
+
+	struct Step
+	{
+		eClientMessage command;
+		eLiveSplitTimerPhase serverPhase;
+	};
+
+	static constexpr Step steps[] = {
+		{eClientMessage::StartTimer, Running},
+		{eClientMessage::Pause, Paused},
+		{eClientMessage::Pause, Paused},
+		{eClientMessage::Resume, Running},
+		{eClientMessage::Split, Running},
+		{eClientMessage::Split, Ended},
+		{eClientMessage::Unsplit, Running},
+		{eClientMessage::StartOrSplit, Ended},
+		{eClientMessage::Reset, NotRunning},
+		{eClientMessage::StartOrSplit, Running},
+	};
+
+	LiveSplitWriter writer;
+	writer.onConnected();
+	CHECK(!writer.getTimerPhase());
+	CHECK(writer.queryTimerPhase(connection) == NotRunning);
+	CHECK(writer.getTimerPhase() == NotRunning);
+
+	for (auto const& step : steps) {
+		auto const predicted = getNextTimerPhase(writer.getTimerPhase(), step.command);
+		CHECK(writer.enqueue(ClientMessage(step.command)));
+		CHECK(writer.getTimerPhase() == predicted);
+
+		auto const endedRun = step.serverPhase == Ended && (step.command == eClientMessage::Split || step.command == eClientMessage::StartOrSplit);
+		CHECK(endedRun ? predicted == Running : predicted == step.serverPhase);
+
+		// Splits make the writer check straight away
+		CHECK(writer.write(connection));
+		auto const isSplit = step.command == eClientMessage::Split || step.command == eClientMessage::StartOrSplit;
+		CHECK(writer.isReconcileDue() == isSplit);
+
+		CHECK(writer.queryTimerPhase(connection) == step.serverPhase);
+		CHECK(writer.getTimerPhase() == step.serverPhase);
+	}
+
+	connection.close();
+	CHECK(server.finish().size() == std::size(steps) * 2 + 1);
+}
+
+int main() {
+#ifdef _WIN32
+	WSADATA wsaData = {};
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return 1;
+#endif
+
+	testWireFormat();
+	testQueueWhenFull();
+	testProducerOrdering();
+	testGameTimeSuperseded();
+	testPendingRetriedAfterReconnect();
+	testFailedQueryRemoved();
+	testPartialSendResent();
+	testTimerPhaseReconcile();
+
+#ifdef _WIN32
+	WSACleanup();
+#endif
+	return failures ? 1 : 0;
+}
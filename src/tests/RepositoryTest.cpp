@@ -0,0 +1,219 @@
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include "LazyRepository.h"
+#include "RepoPacker.h"
+#include "Repository.h"
+#include "json.hpp"
+
+// Packs the real data/repo.json like the RepoPack build step and checks every entry reads back with the fields the
+// mod uses, from both the packed Repository and the LazyRepository reading the JSON directly. Then checks truncated and
+// corrupted data is rejected by both rather than read out of bounds.
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			++failures; \
+		} \
+	} while (false)
+
+static auto readFile(const char* path) -> std::string {
+	std::ifstream input(path, std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+// Checks an entry found in a repository against its object in repo.json
+static auto checkItem(const std::optional<RepoItem>& item, const nlohmann::json& expected) -> bool {
+	if (!item) return false;
+
+	auto const itemType = expected.value("ItemType", "");
+	auto const inventoryCategoryIcon = expected.value("InventoryCategoryIcon", "");
+
+	return item->title == expected.value("Title", "")
+		&& item->commonName == expected.value("CommonName", "")
+		&& item->itemType == itemType
+		&& item->inventoryCategoryIcon == inventoryCategoryIcon
+		&& item->category == classifyRepoItem(itemType, inventoryCategoryIcon)
+		&& item->isHitmanSuit == expected.value("IsHitmanSuit", false);
+}
+
+static auto testPackedRepository(const nlohmann::json& repo) -> void {
+	Repository repository;
+	CHECK(repository.load(packRepository(repo)));
+
+	std::unordered_set<RepoId> seen;
+	auto mismatches = 0;
+
+	for (auto const& expected : repo) {
+		auto const id = RepoId::parse(expected.value("ID_", ""));
+		CHECK(id.has_value());
+		if (!id || !seen.insert(*id).second) continue;
+
+		if (!checkItem(repository.find(*id), expected)) {
+			if (++mismatches <= 10)
+				std::printf("entry %s doesn't match repo.json\n", expected.value("ID_", "").c_str());
+		}
+	}
+
+	std::printf("checked %zu packed entries\n", seen.size());
+	CHECK(mismatches == 0);
+	CHECK(repository.size() == seen.size());
+	CHECK(repository.size() > 2000);
+
+	// Lookups by string are case-insensitive, and anything that isn't a GUID isn't found
+	auto const& first = repo.front();
+	auto upper = first.value("ID_", "");
+	for (auto& c : upper) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+	CHECK(checkItem(repository.find(upper), first));
+	CHECK(!repository.find("not-a-guid"));
+	CHECK(!repository.find(RepoId{}));
+}
+
+static auto testMalformedPacked(const nlohmann::json& repo) -> void {
+	auto const data = packRepository(repo);
+	Repository repository;
+
+	CHECK(!repository.load(std::string_view()));
+	CHECK(repository.size() == 0);
+
+	// Every truncation, from part of the header to missing the last byte of the string table
+	auto truncationsLoaded = 0;
+	for (size_t size = 0; size < data.size(); size += size < 256 ? 1 : 997)
+		truncationsLoaded += repository.load(std::string(data, 0, size));
+	truncationsLoaded += repository.load(std::string(data, 0, data.size() - 1));
+	CHECK(truncationsLoaded == 0);
+	CHECK(repository.size() == 0);
+
+	// Trailing data
+	CHECK(!repository.load(data + '\0'));
+
+	auto corrupt = [&](size_t offset, auto value) {
+		auto copy = data;
+		std::memcpy(copy.data() + offset, &value, sizeof(value));
+		return copy;
+	};
+
+	CHECK(!repository.load(corrupt(offsetof(RepoPack::Header, magic), 'X')));
+	CHECK(!repository.load(corrupt(offsetof(RepoPack::Header, version), RepoPack::Version + 1)));
+	CHECK(!repository.load(corrupt(offsetof(RepoPack::Header, entryCount), uint32_t{0xFFFFFFFF})));
+	CHECK(!repository.load(corrupt(offsetof(RepoPack::Header, stringTableSize), uint32_t{0xFFFFFFFF})));
+
+	// A string reference past the string table reads as empty rather than out of bounds
+	auto const firstTitle = sizeof(RepoPack::Header) + offsetof(RepoPack::Entry, title);
+	CHECK(repository.load(corrupt(firstTitle, RepoPack::StringRef{0xFFFFFFF0, 0x100})));
+	auto entry = RepoPack::Entry();
+	std::memcpy(&entry, data.data() + sizeof(RepoPack::Header), sizeof(entry));
+	auto const item = repository.find(RepoId{entry.idHigh, entry.idLow});
+	CHECK(item && item->title.empty());
+
+	// An empty repository packs and loads, it just has nothing in it
+	CHECK(repository.load(packRepository(nlohmann::json::array())));
+	CHECK(repository.size() == 0);
+	CHECK(!repository.find(RepoId{1, 1}));
+}
+
+static auto testLazyRepository(const nlohmann::json& repo, std::string_view json) -> void {
+	Repository packed;
+	CHECK(packed.load(packRepository(repo)));
+
+	LazyRepository lazy;
+	CHECK(lazy.load(json));
+	CHECK(lazy.size() == packed.size());
+	CHECK(lazy.decodedCount() == 0);
+
+	std::unordered_set<RepoId> seen;
+	auto mismatches = 0;
+
+	for (auto const& expected : repo) {
+		auto const id = RepoId::parse(expected.value("ID_", ""));
+		if (!id || !seen.insert(*id).second) continue;
+
+		auto const lazyItem = lazy.find(*id);
+		auto const packedItem = packed.find(*id);
+
+		auto const matches = checkItem(lazyItem, expected)
+			&& packedItem
+			&& lazyItem->title == packedItem->title
+			&& lazyItem->commonName == packedItem->commonName
+			&& lazyItem->itemType == packedItem->itemType
+			&& lazyItem->inventoryCategoryIcon == packedItem->inventoryCategoryIcon
+			&& lazyItem->category == packedItem->category
+			&& lazyItem->isHitmanSuit == packedItem->isHitmanSuit;
+
+		if (!matches && ++mismatches <= 10)
+			std::printf("lazy entry %s doesn't match the packed one\n", expected.value("ID_", "").c_str());
+	}
+
+	std::printf("checked %zu lazy entries\n", seen.size());
+	CHECK(mismatches == 0);
+	CHECK(lazy.decodedCount() == seen.size());
+
+	// Cached lookups give the same strings
+	auto const& first = repo.front();
+	CHECK(checkItem(lazy.find(first.value("ID_", "")), first));
+	CHECK(lazy.decodedCount() == seen.size());
+	CHECK(!lazy.find("not-a-guid"));
+}
+
+static auto testMalformedJson(std::string_view json) -> void {
+	LazyRepository lazy;
+
+	CHECK(!lazy.load(""));
+	CHECK(!lazy.load("   "));
+	CHECK(!lazy.load("{}"));
+	CHECK(!lazy.load("\"[]\""));
+	CHECK(!lazy.load("[{\"ID_\": \"00000000-0000-0000-0000-000000000001\"}"));
+	CHECK(!lazy.load("[{\"ID_\": \"00000000-0000-0000-0000-000000000001}]"));
+	CHECK(!lazy.load("[}]]"));
+	CHECK(lazy.size() == 0);
+
+	// Every truncation of the real data fails rather than indexing part of it
+	auto truncationsLoaded = 0;
+	for (size_t size = 0; size < json.size(); size += size < 256 ? 1 : 997)
+		truncationsLoaded += lazy.load(json.substr(0, size));
+	CHECK(truncationsLoaded == 0);
+	CHECK(lazy.size() == 0);
+
+	// Brackets and braces in strings and escaped quotes don't confuse the indexing
+	std::string_view const tricky = R"([
+		{"ID_": "00000000-0000-0000-0000-000000000001", "Title": "Braces } ] in \"quotes\\", "IsHitmanSuit": true},
+		{"Nested": {"ID_": "00000000-0000-0000-0000-000000000002"}, "ID_": "00000000-0000-0000-0000-000000000003"},
+		{"Title": "No ID"},
+		{"ID_": "00000000-0000-0000-0000-000000000004", "Title": 5}
+	])";
+	CHECK(lazy.load(tricky));
+	CHECK(lazy.size() == 3);
+
+	auto const first = lazy.find("00000000-0000-0000-0000-000000000001");
+	CHECK(first && first->title == "Braces } ] in \"quotes\\" && first->isHitmanSuit);
+	CHECK(!lazy.find("00000000-0000-0000-0000-000000000002"));
+	CHECK(lazy.find("00000000-0000-0000-0000-000000000003").has_value());
+
+	// An entry whose fields have the wrong types is treated as missing, and stays so
+	CHECK(!lazy.find("00000000-0000-0000-0000-000000000004"));
+	CHECK(!lazy.find("00000000-0000-0000-0000-000000000004"));
+}
+
+int main() {
+	auto const json = readFile(STEALTHOMETER_REPO_JSON);
+	auto const repo = nlohmann::json::parse(json, nullptr, false);
+	CHECK(repo.is_array() && !repo.empty());
+	if (!repo.is_array() || repo.empty()) return 1;
+
+	testPackedRepository(repo);
+	testMalformedPacked(repo);
+	testLazyRepository(repo, json);
+	testMalformedJson(json);
+
+	return failures ? 1 : 0;
+}
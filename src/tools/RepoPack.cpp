@@ -0,0 +1,52 @@
+// Build step which converts data/repo.json into the packed repository embedded in the plugin.
+// Usage: RepoPack <repo.json> <repo.bin>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include "../RepoPacker.h"
+#include "../Repository.h"
+
+auto main(int argc, char** argv) -> int {
+	if (argc != 3) {
+		std::cerr << "Usage: RepoPack <repo.json> <repo.bin>\n";
+		return 1;
+	}
+
+	std::ifstream input(argv[1], std::ios::binary);
+	if (!input) {
+		std::cerr << "RepoPack: failed to open " << argv[1] << "\n";
+		return 1;
+	}
+
+	nlohmann::json repo;
+	try {
+		repo = nlohmann::json::parse(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+	}
+	catch (const nlohmann::json::exception& ex) {
+		std::cerr << "RepoPack: " << ex.what() << "\n";
+		return 1;
+	}
+
+	if (!repo.is_array()) {
+		std::cerr << "RepoPack: " << argv[1] << " is not a JSON array\n";
+		return 1;
+	}
+
+	auto data = packRepository(repo);
+
+	Repository check;
+	if (!check.load(std::string_view(data))) {
+		std::cerr << "RepoPack: packed repository failed to load\n";
+		return 1;
+	}
+
+	std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+	output.write(data.data(), static_cast<std::streamsize>(data.size()));
+	if (!output) {
+		std::cerr << "RepoPack: failed to write " << argv[2] << "\n";
+		return 1;
+	}
+
+	std::cout << "RepoPack: packed " << check.size() << " entries into " << data.size() << " bytes\n";
+	return 0;
+}
@@ -1,32 +1,92 @@
 #pragma once
 #include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <string_view>
 
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define STEALTHOMETER_SSE2 1
+#endif
+
+constexpr auto asciiToLower(unsigned char c) -> unsigned char {
+	return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+}
+
+#ifdef STEALTHOMETER_SSE2
+// Lowercases the ASCII letters in 16 bytes at once.
+inline auto asciiToLower(__m128i chars) -> __m128i {
+	// Shift so 'A'..'Z' become the lowest 26 signed byte values, then select them with a single compare.
+	auto const shifted = _mm_sub_epi8(chars, _mm_set1_epi8(static_cast<char>('A' + 128)));
+	auto const isUpper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + 26)));
+	return _mm_or_si128(chars, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+// Case-insensitive (ASCII) string equality. Transparent, so string_view lookups don't need a std::string.
 struct InsensitiveCompare
 {
+	using is_transparent = void;
+
 	auto operator()(std::string_view a, std::string_view b) const -> bool {
-		return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char a, unsigned char b) {
-			return std::tolower(a) == std::tolower(b);
-		});
+		if (a.size() != b.size()) return false;
+
+		size_t i = 0;
+
+#ifdef STEALTHOMETER_SSE2
+		for (; i + 16 <= a.size(); i += 16) {
+			auto const la = asciiToLower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + i)));
+			auto const lb = asciiToLower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + i)));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(la, lb)) != 0xFFFF) return false;
+		}
+#endif
+
+		for (; i < a.size(); ++i) {
+			if (asciiToLower(a[i]) != asciiToLower(b[i])) return false;
+		}
+
+		return true;
 	}
 };
 
 struct InsensitiveCompareLexicographic
 {
+	using is_transparent = void;
+
 	auto operator()(std::string_view a, std::string_view b) const -> bool {
 		return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char a, unsigned char b) {
-			return std::tolower(a) < std::tolower(b);
+			return asciiToLower(a) < asciiToLower(b);
 		});
 	}
 };
 
+// Case-insensitive (ASCII) string hash, consistent with InsensitiveCompare. Hashes in place without allocating.
 struct StringHashLowercase
 {
-public:
-	auto operator()(const std::string& str) const {
-		std::string lower;
-		std::transform(str.begin(), str.end(), std::back_inserter(lower), [](unsigned char c) -> unsigned char { return std::tolower(c); });
-		return std::hash<std::string>()(lower);
+	using is_transparent = void;
+
+	auto operator()(std::string_view str) const -> size_t {
+		constexpr uint64_t prime = 0x100000001B3ull;
+		uint64_t hash = 0xCBF29CE484222325ull ^ str.size();
+		size_t i = 0;
+
+#ifdef STEALTHOMETER_SSE2
+		for (; i + 16 <= str.size(); i += 16) {
+			auto const lower = asciiToLower(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str.data() + i)));
+			uint64_t words[2];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(words), lower);
+			hash = (hash ^ words[0]) * prime;
+			hash = std::rotl(hash, 29);
+			hash = (hash ^ words[1]) * prime;
+			hash = std::rotl(hash, 29);
+		}
+#endif
+
+		for (; i < str.size(); ++i)
+			hash = (hash ^ asciiToLower(str[i])) * prime;
+
+		return static_cast<size_t>(hash ^ (hash >> 32));
 	}
 };